@@ -5,6 +5,9 @@
  * uint8_t width_index    = 1;
  * uint8_t height_index   = 2;
  *
+ * AVR_5_by_8_font_bcs_hv_index holds the byte offset of every character,
+ * register it with uc_fonts_register_progmem_index() for O(1) lookups.
+ *
  */
 
 #ifndef AVR_5_BY_8_FONT_BCS_HV
@@ -14,4 +17,6 @@
 
 const uint8_t AVR_5_by_8_font_bcs_hv[799] PROGMEM = {0x60, 0x05, 0x08, 0x01, 0x3f, 0xde, 0xb9, 0xff, 0xfe, 0x01, 0x40, 0x29, 0x05, 0xa2, 0x03, 0x01, 0x40, 0x29, 0x00, 0x5c, 0x04, 0x01, 0x40, 0xd5, 0x18, 0x15, 0x01, 0x01, 0x00, 0x30, 0x5a, 0x69, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x84, 0x10, 0x42, 0x08, 0x20, 0x01, 0x4a, 0x01, 0x00, 0x00, 0x00, 0x01, 0x4a, 0x7d, 0xa5, 0xbe, 0x52, 0x01, 0xc4, 0x97, 0xe2, 0xe8, 0x23, 0x01, 0x73, 0x21, 0x42, 0x84, 0xce, 0x01, 0x26, 0xa5, 0x22, 0x6a, 0xba, 0x01, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x88, 0x08, 0x21, 0x04, 0x41, 0x01, 0x82, 0x20, 0x84, 0x10, 0x11, 0x01, 0xa0, 0xba, 0x0a, 0x00, 0x00, 0x01, 0x00, 0x10, 0xf2, 0x09, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x21, 0x01, 0x00, 0x00, 0xf0, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x20, 0x01, 0x10, 0x21, 0x42, 0x84, 0x08, 0x01, 0x2e, 0xc6, 0x58, 0x63, 0x74, 0x01, 0xc4, 0x14, 0x42, 0x08, 0xf9, 0x01, 0x2e, 0x42, 0x44, 0x44, 0xf8, 0x01, 0x2e, 0x42, 0xc8, 0x60, 0x74, 0x01, 0x44, 0x88, 0x50, 0x3e, 0x21, 0x01, 0x3f, 0x84, 0xe0, 0x60, 0x74, 0x01, 0x2e, 0x84, 0xf0, 0x62, 0x74, 0x01, 0x1f, 0x42, 0x44, 0x08, 0x21, 0x01, 0x2e, 0xc6, 0xe8, 0x62, 0x74, 0x01, 0x2e, 0xc6, 0xe8, 0x61, 0x74, 0x01, 0x00, 0x00, 0x02, 0x08, 0x00, 0x01, 0x00, 0x00, 0x40, 0x00, 0x21, 0x01, 0x00, 0x20, 0x22, 0x08, 0x02, 0x01, 0x00, 0x80, 0x0f, 0x3e, 0x00, 0x01, 0x00, 0x08, 0x82, 0x88, 0x00, 0x01, 0x2e, 0x42, 0x44, 0x08, 0x20, 0x01, 0x2e, 0xc6, 0x5e, 0x7b, 0xf0, 0x01, 0x2e, 0xc6, 0xf8, 0x63, 0x8c, 0x01, 0x2f, 0xc6, 0xf8, 0x62, 0x7c, 0x01, 0x2e, 0x86, 0x10, 0x42, 0x74, 0x01, 0x2f, 0xc6, 0x18, 0x63, 0x7c, 0x01, 0x3f, 0x84, 0xf0, 0x42, 0xf8, 0x01, 0x3f, 0x84, 0xf0, 0x42, 0x08, 0x01, 0x2e, 0x86, 0xd0, 0x63, 0x74, 0x01, 0x31, 0xc6, 0xf8, 0x63, 0x8c, 0x01, 0x9f, 0x10, 0x42, 0x08, 0xf9, 0x01, 0x1e, 0x42, 0x08, 0x61, 0x74, 0x01, 0x31, 0x95, 0x31, 0x4a, 0x8a, 0x01, 0x21, 0x84, 0x10, 0x42, 0xf8, 0x01, 0x71, 0xd7, 0x18, 0x63, 0x8c, 0x01, 0x73, 0xd6, 0x5a, 0x73, 0x8e, 0x01, 0x2e, 0xc6, 0x18, 0x63, 0x74, 0x01, 0x2f, 0xc6, 0xf8, 0x42, 0x08, 0x01, 0x2e, 0xc6, 0x18, 0x6b, 0xb2, 0x01, 0x2f, 0xc6, 0xf8, 0x4a, 0x8a, 0x01, 0x3e, 0x84, 0xe0, 0x20, 0x7c, 0x01, 0x9f, 0x10, 0x42, 0x08, 0x21, 0x01, 0x31, 0xc6, 0x18, 0x63, 0x74, 0x01, 0x31, 0xc6, 0xa8, 0x14, 0x21, 0x01, 0x31, 0xc6, 0x18, 0x6b, 0x55, 0x01, 0x31, 0x2a, 0x45, 0x94, 0x8a, 0x01, 0x31, 0x46, 0x45, 0x08, 0x21, 0x01, 0x1f, 0x42, 0x44, 0x44, 0xf8, 0x01, 0x4e, 0x08, 0x21, 0x84, 0x70, 0x01, 0x41, 0x08, 0x42, 0x10, 0x82, 0x01, 0x0e, 0x21, 0x84, 0x10, 0x72, 0x01, 0x44, 0x45, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x01, 0x82, 0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x1f, 0x63, 0xf4, 0x01, 0x21, 0x84, 0x17, 0x63, 0x7c, 0x01, 0x00, 0x00, 0x1f, 0x42, 0xf0, 0x01, 0x10, 0x42, 0x1f, 0x63, 0xf4, 0x01, 0x00, 0x00, 0x93, 0x5e, 0xf0, 0x01, 0x98, 0x90, 0x4f, 0x08, 0x21, 0x01, 0x00, 0x00, 0x97, 0x1c, 0x3a, 0x01, 0x21, 0x84, 0x17, 0x63, 0x8c, 0x01, 0x80, 0x00, 0x43, 0x08, 0x71, 0x01, 0x80, 0x00, 0x42, 0x08, 0x19, 0x01, 0x21, 0x84, 0x32, 0x46, 0x49, 0x01, 0x42, 0x08, 0x21, 0x84, 0x60, 0x01, 0x00, 0x80, 0x57, 0x6b, 0xad, 0x01, 0x00, 0x80, 0x93, 0x52, 0x4a, 0x01, 0x00, 0x00, 0x17, 0x63, 0x74, 0x01, 0x00, 0x00, 0x93, 0x4e, 0x08, 0x01, 0x00, 0x00, 0x93, 0x1c, 0x42, 0x01, 0x00, 0x80, 0x3e, 0x42, 0x08, 0x01, 0x00, 0x00, 0x1f, 0x1c, 0x7c, 0x01, 0x84, 0x10, 0x47, 0x08, 0xc1, 0x01, 0x00, 0x80, 0x18, 0x63, 0xf4, 0x01, 0x00, 0x80, 0x18, 0xa3, 0x22, 0x01, 0x00, 0x80, 0x18, 0x63, 0x55, 0x01, 0x00, 0x80, 0xa8, 0x88, 0x8a, 0x01, 0x00, 0x80, 0x94, 0x1c, 0x3a, 0x01, 0x00, 0x80, 0x0f, 0x99, 0xf8, 0x01, 0x4c, 0x08, 0x11, 0x84, 0x60, 0x01, 0x84, 0x10, 0x42, 0x08, 0x21, 0x01, 0x06, 0x21, 0x04, 0x11, 0x32, 0x01, 0x00, 0x00, 0x51, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3e, 0x18, 0xe4, 0x62, 0x74, 0x00, 0x00, 0x01, 0x26, 0x25, 0x03, 0x00, 0x00, 0x01, 0x00, 0x10, 0x47, 0x80, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x95, 0xa8, 0x18, 0x7f, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0xb8, 0x18, 0x63, 0x74, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0xc4, 0x18, 0x63, 0x74, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x20, 0x01, 0x93, 0x52, 0xf2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x24, 0x60, 0x52, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x24, 0x90, 0x52, 0xf2, 0x00, 0x00, 0x00};
 
+const uint16_t AVR_5_by_8_font_bcs_hv_index[256] PROGMEM = {3, 9, 15, 21, 27, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 67, 73, 79, 85, 91, 97, 103, 109, 115, 121, 127, 133, 139, 145, 151, 157, 163, 169, 175, 181, 187, 193, 199, 205, 211, 217, 223, 229, 235, 241, 247, 253, 259, 265, 271, 277, 283, 289, 295, 301, 307, 313, 319, 325, 331, 337, 343, 349, 355, 361, 367, 373, 379, 385, 391, 397, 403, 409, 415, 421, 427, 433, 439, 445, 451, 457, 463, 469, 475, 481, 487, 493, 499, 505, 511, 517, 523, 529, 535, 541, 547, 553, 559, 565, 571, 577, 583, 589, 595, 601, 607, 613, 619, 625, 626, 627, 628, 629, 630, 631, 632, 633, 634, 635, 636, 637, 638, 639, 640, 641, 642, 643, 644, 645, 646, 647, 648, 649, 650, 651, 652, 653, 654, 655, 656, 657, 658, 659, 660, 661, 662, 663, 664, 665, 666, 667, 668, 669, 670, 671, 677, 678, 679, 685, 691, 692, 693, 694, 695, 696, 697, 698, 699, 700, 701, 702, 703, 704, 705, 706, 707, 708, 709, 715, 716, 717, 718, 719, 720, 721, 722, 723, 724, 725, 726, 727, 728, 729, 730, 731, 732, 738, 739, 740, 741, 742, 743, 749, 750, 751, 752, 753, 754, 755, 756, 762, 763, 764, 765, 766, 767, 768, 769, 770, 771, 772, 773, 774, 775, 776, 777, 778, 779, 785, 786, 787, 788, 789, 790, 796, 797, 798};
+
 #endif
@@ -0,0 +1,341 @@
+/**
+ * This C++ header offers a canvas template whose geometry and memory
+ * layout are template parameters:
+ *
+ * 		uc_canvas<Width, Height, Layout>
+ *
+ * The canvas is a front-end of the C libraries, not a renderer of its
+ * own: every drawing call makes the canvas the render target of the LCD
+ * library (see uc_lcd_set_target) and calls the matching uc_graphics_*,
+ * uc_images_* or uc_fonts_* function, so a canvas gets exactly the pixels
+ * these functions draw, raster operation and clip rectangle included.
+ *
+ * The canvas hands its byte index function to the LCD library as
+ * uc_lcd_canvas_layout. Width, Height and the layout are constants in it,
+ * so the compiler folds the index math and the chip splitting of KS0108
+ * layouts, and uc_lcd_get_target_byte() only calls it.
+ *
+ * Layouts (every byte holds 8 vertical pixels, LSB is the top pixel):
+ * 		- uc_canvas_layout_pages: (Height+7)/8 rows of Width bytes. This is
+ * 		  the layout of uc_lcd_canvas and of most OLED controllers.
+ * 		- uc_canvas_layout_ks0108: columns are split into chips of 64
+ * 		  columns, every chip stores its pages consecutively. This is the
+ * 		  layout of uc_lcd_buffer, e.g. for a second frame which is copied
+ * 		  into uc_lcd_buffer later.
+ *
+ * Drawing calls:
+ * 		- set_pixel, get_pixel, fill_rect, draw_line (graphics library)
+ * 		- blit: bitmap in page layout with optional mask (see uc_lcd_blit)
+ * 		- draw_image: image of the images library
+ * 		- draw_char, draw_string: characters of the fonts library
+ *
+ * Any other function of the libraries draws into the canvas between
+ * select() and LCD_API_SET_TARGET() with the target select() returned.
+ *
+ * Include it after the LCD, images and fonts libraries.
+ *
+ * Example:
+ * 		uc_canvas<32, 16, uc_canvas_layout_pages> panel(panel_buffer);
+ * 		panel.clear();
+ * 		panel.draw_string("OK", 2, 4, 0, 0, AVR_5_by_8_font_bcs_hv);
+ * 		uc_lcd_blit_canvas(96, 48, panel.as_lcd_canvas(), 0);
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_GRAPHICS_CANVAS_TEMPLATE_H_
+#define UC_AVR_GRAPHICS_CANVAS_TEMPLATE_H_
+
+#ifndef __cplusplus
+#error "µC-Graphics canvas template does require a C++ compiler."
+#endif
+
+#if !defined(LCD_API_SET_TARGET) || !defined(LCD_API_GET_TARGET)
+#error "µC-Graphics canvas template does require LCD_API_SET_TARGET and LCD_API_GET_TARGET makros to be set."
+#endif
+
+#if !defined(UC_AVR_GRAPHICS_IMAGES_H_) || !defined(UC_AVR_GRAPHICS_FONTS_H_)
+#error "µC-Graphics canvas template does require the images and fonts libraries to be included first."
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Page layout: row after row of Width bytes.
+ */
+struct uc_canvas_layout_pages {
+	static const uint8_t page_layout = 1;
+	static const uint8_t run_width = 0;
+
+	template<uint8_t Width, uint8_t Height>
+	static uint16_t get_index(uint8_t x, uint8_t page) {
+		return (uint16_t)page * Width + x;
+	}
+};
+
+/*
+ * KS0108 layout: chips of 64 columns, each storing its pages consecutively.
+ */
+struct uc_canvas_layout_ks0108 {
+	static const uint8_t page_layout = 0;
+	static const uint8_t run_width = 64;
+
+	template<uint8_t Width, uint8_t Height>
+	static uint16_t get_index(uint8_t x, uint8_t page) {
+		return (uint16_t)(x / 64) * (((Height + 7)/8) * 64) + (uint16_t)page * 64 + (x % 64);
+	}
+};
+
+template<uint8_t Width, uint8_t Height, class Layout>
+class uc_canvas {
+
+	public:
+
+		static const uint8_t width = Width;
+		static const uint8_t height = Height;
+		static const uint8_t pages = (Height + 7)/8;
+		static const uint16_t size = (uint16_t)Width * ((Height + 7)/8);
+
+		uint8_t *buffer;
+
+		/**
+		 * Creates a canvas on memory of uc_canvas::size bytes.
+		 *
+		 * params:
+		 * 		- buffer: memory of canvas
+		 */
+		uc_canvas(uint8_t *buffer) : buffer(buffer) {
+			target.buffer = buffer;
+			target.width = Width;
+			target.height = Height;
+			target.layout = &layout;
+		}
+
+		/**
+		 * Retrieves the buffer index of the byte which holds the 8 pixels
+		 * of a column within a page.
+		 *
+		 * params:
+		 * 		- x: x coordinate of column
+		 * 		- page: index of vertical set of 8 pixels
+		 *
+		 * returns: index of byte.
+		 */
+		static uint16_t get_index(uint8_t x, uint8_t page) {
+			return Layout::template get_index<Width, Height>(x, page);
+		}
+
+		/**
+		 * Retrieves the byte which holds the 8 pixels of a column within a page.
+		 *
+		 * params:
+		 * 		- x: x coordinate of column
+		 * 		- page: index of vertical set of 8 pixels
+		 *
+		 * returns: pointer to byte.
+		 */
+		uint8_t *get_byte(uint8_t x, uint8_t page) {
+			return &buffer[get_index(x, page)];
+		}
+
+		/**
+		 * Sets all pixels to a value.
+		 *
+		 * params:
+		 * 		- pixel: pixel value (0 or 1)
+		 */
+		void clear(uint8_t pixel = 0) {
+			memset(buffer, pixel ? 0xFF : 0x00, size);
+		}
+
+		/**
+		 * Makes the canvas the render target, so every function of the
+		 * libraries draws into it.
+		 *
+		 * returns: previous render target, to be restored with LCD_API_SET_TARGET.
+		 */
+		uc_lcd_canvas *select() {
+			uc_lcd_canvas *previous = LCD_API_GET_TARGET();
+			LCD_API_SET_TARGET(&target);
+			return previous;
+		}
+
+		/**
+		 * Sets a pixel, see LCD_API_SET_PIXEL.
+		 *
+		 * params:
+		 * 		- x: x coordinate of pixel
+		 * 		- y: y coordinate of pixel
+		 * 		- pixel: pixel value (0 or 1)
+		 */
+		void set_pixel(uint8_t x, uint8_t y, uint8_t pixel) {
+			uc_lcd_canvas *previous = select();
+			LCD_API_SET_PIXEL(x, y, pixel);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Retrieves a pixel, see LCD_API_GET_PIXEL.
+		 *
+		 * params:
+		 * 		- x: x coordinate of pixel
+		 * 		- y: y coordinate of pixel
+		 *
+		 * returns: pixel value (0 or 1).
+		 */
+		uint8_t get_pixel(uint8_t x, uint8_t y) {
+			uc_lcd_canvas *previous = select();
+			uint8_t pixel = LCD_API_GET_PIXEL(x, y);
+			LCD_API_SET_TARGET(previous);
+			return pixel;
+		}
+
+		/**
+		 * Fills a rectangle, see uc_graphics_fill_rect.
+		 *
+		 * params:
+		 * 		- x: x coordinate of left column
+		 * 		- y: y coordinate of top row
+		 * 		- w: width of rectangle
+		 * 		- h: height of rectangle
+		 * 		- pixel: pixel value (0 or 1)
+		 */
+		void fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t pixel) {
+			uc_lcd_canvas *previous = select();
+			uc_graphics_fill_rect(x, y, w, h, pixel);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Draws a line between two points, see uc_graphics_draw_line.
+		 *
+		 * params:
+		 * 		- x1: x coordinate of first point
+		 * 		- y1: y coordinate of first point
+		 * 		- x2: x coordinate of second point
+		 * 		- y2: y coordinate of second point
+		 * 		- pixel: pixel value (0 or 1)
+		 */
+		void draw_line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t pixel) {
+			uc_lcd_canvas *previous = select();
+			uc_graphics_draw_line(x1, y1, x2, y2, pixel);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Draws a bitmap in page layout with optional mask, see LCD_API_BLIT.
+		 *
+		 * params:
+		 * 		- x: x coordinate of left column
+		 * 		- y: y coordinate of top row
+		 * 		- w: width of bitmap
+		 * 		- h: height of bitmap
+		 * 		- bitmap: pixel bytes (1 = black)
+		 * 		- mask: mask bytes (1 = draw pixel) or 0 to draw all pixels
+		 * 		- progmem: 1 if bitmap and mask are stored in progmem, 0 if in RAM
+		 */
+		void blit(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+				  const uint8_t *bitmap, const uint8_t *mask, uint8_t progmem) {
+
+			uc_lcd_canvas *previous = select();
+			LCD_API_BLIT(x, y, w, h, bitmap, mask, progmem);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Draws an image of the images library, see uc_images_draw.
+		 *
+		 * params:
+		 * 		- x: x coordinate to start drawing the image
+		 * 		- y: y coordinate to start drawing the image
+		 * 		- draw_white_pixels: if 1, white (0) pixels will be drawn, if 0 not
+		 * 		- progmem_img: image stored in progmem
+		 */
+		void draw_image(uint8_t x, uint8_t y, uint8_t draw_white_pixels, const uint8_t *progmem_img) {
+			uc_lcd_canvas *previous = select();
+			uc_images_draw(x, y, draw_white_pixels, progmem_img);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Draws a character of a font, see uc_fonts_draw_char.
+		 *
+		 * params:
+		 * 		- char_code: code of character
+		 * 		- x: x coordinate of pen position
+		 * 		- y: y coordinate to start drawing
+		 * 		- draw_white_pixels: if 1, also white pixels will be drawn, if 0 only black pixels will be drawn
+		 * 		- progmem_font: font in progmem
+		 */
+		void draw_char(uint16_t char_code, uint8_t x, uint8_t y, uint8_t draw_white_pixels, const uint8_t *progmem_font) {
+			uc_lcd_canvas *previous = select();
+			uc_fonts_draw_char(char_code, x, y, draw_white_pixels, progmem_font);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Draws a series of characters, see uc_fonts_draw_string.
+		 *
+		 * params:
+		 * 		- string: string to draw
+		 * 		- x: x coordinate to start drawing
+		 * 		- y: y coordinate to start drawing
+		 * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too
+		 * 		- fill_char_gaps: if 1, gaps between chars are overridden by white pixels
+		 * 		- progmem_font: font in progmem
+		 */
+		void draw_string(const char *string, uint8_t x, uint8_t y, uint8_t draw_white_pixels,
+						 uint8_t fill_char_gaps, const uint8_t *progmem_font) {
+
+			uc_lcd_canvas *previous = select();
+			uc_fonts_draw_string((char*)string, x, y, draw_white_pixels, fill_char_gaps, progmem_font);
+			LCD_API_SET_TARGET(previous);
+		}
+
+		/**
+		 * Retrieves the canvas as uc_lcd_canvas, e.g. to composite it with
+		 * uc_lcd_blit_canvas, which requires page layout.
+		 *
+		 * returns: canvas description sharing the buffer.
+		 */
+		const uc_lcd_canvas *as_lcd_canvas() {
+			static_assert(Layout::page_layout, "Only canvases in page layout can be composited as uc_lcd_canvas.");
+			return &target;
+		}
+
+	private:
+
+		uc_lcd_canvas target;
+		static const uc_lcd_canvas_layout layout;
+};
+
+template<uint8_t Width, uint8_t Height, class Layout>
+const uc_lcd_canvas_layout uc_canvas<Width, Height, Layout>::layout = {
+	&uc_canvas<Width, Height, Layout>::get_index, Layout::run_width
+};
+
+#endif
@@ -7,18 +7,82 @@
  *  - bit 6 == 1: format of byte array: byte chain with search due to emtpy chars (bcs)
  * 	- bit 5 == 1: left to right, top to bottom (hv)
  * 	- bit 4 == 1: top to bottom, left to right (vh)
+ * 	- bit 3 == 1: page major (pm): (height+7)/8 rows of width bytes per
+ * 	  character, every byte holds 8 vertical pixels of a column (LSB is
+ * 	  the top pixel). This is the layout of KS0108 style display buffers,
+ * 	  so characters are copied byte wise from flash without repacking.
+ * 	- bit 2 == 1: proportional (pr, together with bcs): every character
+ * 	  has its own advance, bitmap width and bearing, pixels are stored
+ * 	  for the bitmap width only (see uc_fonts_get_glyph). The width byte
+ * 	  holds the widest bitmap.
+ * 	- bit 1 == 1: ranged (rg): characters are unicode code points stored
+ * 	  in ranges, see below. Strings drawn with these fonts are decoded as
+ * 	  UTF-8.
  *
  * 	The second and third byte store the width and
  * 	height of an font character.
  *
+ * 	Ranged fonts continue with the amount of ranges (byte 3) and a table of
+ * 	6 bytes per range, sorted by code point: first code point, last code
+ * 	point and byte index of the first character (16 bit each, LSB first).
+ * 	The characters of a range follow each other like in a 'bcs' font, so
+ * 	flash is only used for the characters which are included. Looking up a
+ * 	character is a binary search over the ranges. Code points which are not
+ * 	included are drawn as code point 0, if the font has it. UTF-8 sequences
+ * 	of up to 3 bytes are decoded (code points up to 0xFFFF).
  *
- * 	Byte 3 & up store the pixels stored LSB and zero padded consecutively.
+ *
+ * 	Byte 3 & up store the pixels stored LSB and zero padded consecutively
+ * 	(hv/vh) or as page bytes (pm).
  * 	For more details or to encode your own font, visit the
  * 	µC-Graphics-Tools project:
  *
  * 	https://github.com/hedgehogs-mind/uc-graphics-tools
  *
  *
+ * Looking up a character of a 'bcs' font walks all preceding characters.
+ * For O(1) lookups register an index per font: either build one in RAM
+ * for a range of characters with uc_fonts_build_index() or register an
+ * offset table stored in progmem with uc_fonts_register_progmem_index().
+ * Up to UC_FONTS_INDEX_SLOTS (default 2) fonts can be indexed at a time.
+ *
+ * Strings advance by the metrics of every character (width + 1 pixel gap
+ * for fixed width fonts) plus the kerning of the character pair, if a
+ * kerning table has been registered with uc_fonts_set_kerning().
+ *
+ * Strings and texts can be measured without drawing them: string widths,
+ * line breaks and the extent of text blocks are calculated with the same
+ * metrics and line breaking as the draw functions use.
+ *
+ * If the LCD sets LCD_API_FAST_BLIT, characters are decoded into columns
+ * of page bytes first and drawn with LCD_API_BLIT: at page aligned y one
+ * buffer byte per column is combined, otherwise two. Characters of more
+ * than UC_FONTS_MAX_GLYPH_BYTES (default 32, width * ((height+7)/8)) bytes
+ * are drawn pixel by pixel.
+ *
+ * Decoded characters can be kept in a direct mapped RAM cache of
+ * UC_FONTS_GLYPH_CACHE_SLOTS (default 0 = no cache) slots, keyed by font
+ * and char code. Every slot takes UC_FONTS_MAX_GLYPH_BYTES + 8 bytes.
+ * Characters drawn over and over (digits, units) are then blitted without
+ * lookup and decoding. uc_fonts_glyph_cache_hits and
+ * uc_fonts_glyph_cache_misses count the lookups to size the cache. Page
+ * major (pm) fonts are blitted from flash and are not cached.
+ *
+ * Characters can be drawn 2, 3 or 4 times as large without extra font
+ * data (uc_fonts_draw_char_scaled, uc_fonts_draw_string_scaled). With
+ * LCD_API_FAST_BLIT the page bytes of a decoded character are stretched
+ * by a lookup table (one nibble of a column into 4 * scale bits) and
+ * repeated for the widened columns, then blitted at once. Scaled
+ * characters of more than UC_FONTS_MAX_SCALED_GLYPH_BYTES (default 128)
+ * bytes are drawn as scale x scale blocks per pixel.
+ *
+ *
+ * Characters are drawn through LCD_API_SET_PIXEL, so the raster operation
+ * of the LCD is honoured: black pixels are the source pixels, white pixels
+ * (draw_white_pixels) are source pixels of value 0. With XOR text can be
+ * toggled on and off without redrawing the background.
+ *
+ *
  *
  *
  * This is free software:
@@ -52,12 +116,95 @@
 #endif
 
 #include <avr/pgmspace.h>
+#include <string.h>
 #include "../graphics/graphics.h"
 
 #define UC_FONTS_SETTINGS_BIT_BC_MASK	(1 << 7)
 #define UC_FONTS_SETTINGS_BIT_BCS_MASK 	(1 << 6)
 #define UC_FONTS_SETTINGS_BIT_HV_MASK	(1 << 5)
 #define UC_FONTS_SETTINGS_BIT_VH_MASK	(1 << 4)
+#define UC_FONTS_SETTINGS_BIT_PM_MASK	(1 << 3)
+#define UC_FONTS_SETTINGS_BIT_PR_MASK	(1 << 2)
+#define UC_FONTS_SETTINGS_BIT_RG_MASK	(1 << 1)
+
+#ifndef UC_FONTS_INDEX_SLOTS
+	//Change here or set macro before including this header file!
+	#define UC_FONTS_INDEX_SLOTS 2
+#endif
+
+#ifndef UC_FONTS_MAX_GLYPH_BYTES
+	//Change here or set macro before including this header file!
+	#define UC_FONTS_MAX_GLYPH_BYTES 32
+#endif
+
+#ifndef UC_FONTS_KERNING_SLOTS
+	//Change here or set macro before including this header file!
+	#define UC_FONTS_KERNING_SLOTS 1
+#endif
+
+#ifndef UC_FONTS_GLYPH_CACHE_SLOTS
+	//Change here or set macro before including this header file!
+	#define UC_FONTS_GLYPH_CACHE_SLOTS 0
+#endif
+
+#ifndef UC_FONTS_MAX_SCALED_GLYPH_BYTES
+	//Change here or set macro before including this header file!
+	#define UC_FONTS_MAX_SCALED_GLYPH_BYTES 128
+#endif
+
+struct uc_fonts_index_struct {
+	const uint8_t *progmem_font;	//0 if slot is free
+	const uint16_t *offsets;		//byte offset of every indexed character
+	uint8_t first;					//code of first indexed character
+	uint16_t count;					//amount of indexed characters
+	uint8_t progmem;				//1 if offsets are stored in progmem
+};
+
+typedef struct uc_fonts_index_struct uc_fonts_index;
+
+uc_fonts_index uc_fonts_indices[UC_FONTS_INDEX_SLOTS];
+
+/*
+ * Retrieves the registered index of a font or 0.
+ */
+uc_fonts_index* uc_fonts_find_index(const uint8_t *progmem_font) {
+	for ( uint8_t i = 0; i < UC_FONTS_INDEX_SLOTS; i++ ) {
+		if ( uc_fonts_indices[i].progmem_font == progmem_font ) return &uc_fonts_indices[i];
+	}
+	return 0;
+}
+
+/*
+ * Stores an index in the slot of the font or in a free slot.
+ */
+uint8_t uc_fonts_register_index(const uint8_t *progmem_font,
+								const uint16_t *offsets,
+								uint8_t first,
+								uint16_t count,
+								uint8_t progmem) {
+
+	uc_fonts_index *index = uc_fonts_find_index(progmem_font);
+	if ( !index ) index = uc_fonts_find_index(0);
+	if ( !index ) return 0;
+
+	index->progmem_font = progmem_font;
+	index->offsets = offsets;
+	index->first = first;
+	index->count = count;
+	index->progmem = progmem;
+	return 1;
+}
+
+/**
+ * Unregisters the index of a font, e.g. before the RAM of the offsets is reused.
+ *
+ * params:
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_fonts_remove_index(const uint8_t *progmem_font) {
+	uc_fonts_index *index = uc_fonts_find_index(progmem_font);
+	if ( index ) index->progmem_font = 0;
+}
 
 /**
  * Retrieves settings byte of font stored in progmem.
@@ -95,6 +242,16 @@ uint8_t uc_fonts_get_char_height(const uint8_t *progmem_font) {
 	return pgm_read_byte(&progmem_font[2]);
 }
 
+/*
+ * Retrieves the amount of pixel bytes of a bitmap of a font.
+ */
+uint16_t uc_fonts_get_bitmap_size(uint8_t settings, uint8_t width, uint8_t height) {
+	if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) return width * ((height + 7)/8);
+
+	uint16_t wh = width*height;
+	return (wh/8) + ((wh%8) > 0 ? 1 : 0);
+}
+
 /**
  * Retrieve the amount of byte a character which is not empty occupies
  * in a byte array/font stored in progmem.
@@ -107,6 +264,8 @@ uint8_t uc_fonts_get_char_height(const uint8_t *progmem_font) {
 uint16_t uc_fonts_get_bytes_per_non_empty_char(const uint8_t *progmem_font) {
 	uint8_t width = pgm_read_byte(&progmem_font[1]);
 	uint8_t height = pgm_read_byte(&progmem_font[2]);
+	if ( pgm_read_byte(&progmem_font[0]) & UC_FONTS_SETTINGS_BIT_PM_MASK ) return 1 + width * ((height + 7)/8);
+
 	uint16_t wh = width*height;
 	return 1 + (wh/8) + ((wh%8) > 0 ? 1 : 0);
 }
@@ -121,30 +280,42 @@ uint16_t uc_fonts_get_bytes_per_non_empty_char(const uint8_t *progmem_font) {
  *
  * returns: index of first byte that belongs to a character (hasPixels-flag byte).
  */
-uint16_t uc_fonts_bc_get_char_index(uint8_t char_code,
+uint16_t uc_fonts_bc_get_char_index(uint16_t char_code,
 									const uint8_t *progmem_font) {
 
 	return 3 + (char_code * uc_fonts_get_bytes_per_non_empty_char(progmem_font));
 }
 
-/**
- * Retrieve the index of the first character byte in a font stored in progmem
- * and of format 'bcs'.
- *
- * params:
- * 		- char_code: code of character to get index for
- * 		- progmem_font: font stored in progmem
- *
- * returns: index of first byte that belongs to a character (hasPixels-flag byte).
+/*
+ * Walks the characters of a 'bcs' font from a known character to another
+ * one, returns the index of the first byte of char_code.
  */
-uint16_t uc_fonts_bcs_get_char_index(uint8_t char_code,
-									 const uint8_t *progmem_font) {
+uint16_t uc_fonts_bcs_walk_char_index(uint16_t char_code,
+									  uint16_t start_code,
+									  uint16_t start_index,
+									  const uint8_t *progmem_font) {
 
 	uint8_t bytes_per_non_empty_char = uc_fonts_get_bytes_per_non_empty_char(progmem_font);
 
-	uint16_t byte_index = 3; //First byte after height byte
+	uint16_t byte_index = start_index;
+
+	if ( pgm_read_byte(&progmem_font[0]) & UC_FONTS_SETTINGS_BIT_PR_MASK ) {
+		//Proportional: size of pixel bytes depends on bitmap width of character
+		uint8_t settings = pgm_read_byte(&progmem_font[0]);
+		uint8_t height = pgm_read_byte(&progmem_font[2]);
+
+		for ( uint16_t i = start_code; i < char_code; i++ ) {
+			if ( pgm_read_byte(&progmem_font[byte_index]) ) {
+				byte_index += 3 + uc_fonts_get_bitmap_size(settings, pgm_read_byte(&progmem_font[byte_index + 1]), height);
+			} else {
+				byte_index++;
+			}
+		}
+
+		return byte_index;
+	}
 
-	for ( uint8_t i = 0; i < char_code; i++ ) {
+	for ( uint16_t i = start_code; i < char_code; i++ ) {
 		if ( pgm_read_byte(&progmem_font[byte_index]) ) {
 			//Char is not empty -> increase index by bytes_per_non_empty_char
 			byte_index += bytes_per_non_empty_char;
@@ -157,305 +328,1227 @@ uint16_t uc_fonts_bcs_get_char_index(uint8_t char_code,
 	return byte_index;
 }
 
+/**
+ * Retrieve the index of the first character byte in a font stored in progmem
+ * and of format 'bcs'.
+ *
+ * params:
+ * 		- char_code: code of character to get index for
+ * 		- progmem_font: font stored in progmem
+ *
+ * returns: index of first byte that belongs to a character (hasPixels-flag byte).
+ */
+uint16_t uc_fonts_bcs_get_char_index(uint16_t char_code,
+									 const uint8_t *progmem_font) {
+
+	return uc_fonts_bcs_walk_char_index(char_code, 0, 3, progmem_font);
+}
 
 /**
- * Draws a font.
+ * Retrieve the index of the first character byte in a font stored in progmem
+ * and of format 'rg'. The ranges are binary searched, characters within a
+ * range are stored with a fixed size (walked for proportional fonts).
  *
  * params:
- * 		- char_code: code of character
- * 		- x: x coordinate to start drawing
- * 		- y: y coordinate to start drawing
- * 		- draw_white_pixels: if 1, also white pixels will be drawn, if 0 only black pixels will be drawn
- * 		- progmem_font: font in progmem
+ * 		- char_code: code point of character to get index for
+ * 		- progmem_font: font stored in progmem
+ *
+ * returns: index of first byte that belongs to a character (hasPixels-flag byte), 0 if the font has no such character.
  */
-void uc_fonts_draw_char(uint8_t char_code,
-						uint8_t x,
-						uint8_t y,
-						uint8_t draw_white_pixels,
-						const uint8_t *progmem_font) {
+uint16_t uc_fonts_rg_get_char_index(uint16_t char_code,
+									const uint8_t *progmem_font) {
 
-	uint8_t settings = pgm_read_byte(&progmem_font[0]);
-	uint8_t width = pgm_read_byte(&progmem_font[1]);
-	uint8_t height = pgm_read_byte(&progmem_font[2]);
-	uint8_t wh = width * height;
+	uint8_t low = 0;
+	uint8_t high = pgm_read_byte(&progmem_font[3]);
 
-	if ( char_code == 32 ) {
-		if ( draw_white_pixels ) {
-			for ( uint8_t cy = y; cy < y+height; cy++ ) {
-				for ( uint8_t cx = x; cx < x+width; cx++ ) {
-					LCD_API_SET_PIXEL(cx, cy, 0);
-				}
+	while ( low < high ) {
+		uint8_t middle = (low + high) / 2;
+		const uint8_t *range = &progmem_font[4 + middle * 6];
+
+		if ( char_code < pgm_read_word(&range[0]) ) {
+			high = middle;
+		} else if ( char_code > pgm_read_word(&range[2]) ) {
+			low = middle + 1;
+		} else {
+			uint16_t position = char_code - pgm_read_word(&range[0]);
+			uint16_t byte_index = pgm_read_word(&range[4]);
+
+			if ( pgm_read_byte(&progmem_font[0]) & UC_FONTS_SETTINGS_BIT_PR_MASK ) {
+				return uc_fonts_bcs_walk_char_index(position, 0, byte_index, progmem_font);
 			}
+			return byte_index + position * uc_fonts_get_bytes_per_non_empty_char(progmem_font);
 		}
-		return;
 	}
 
-	uint16_t char_byte_index = 0;
-	if ( settings & UC_FONTS_SETTINGS_BIT_BC_MASK ) {
-		char_byte_index = uc_fonts_bc_get_char_index(char_code, progmem_font);
-	} else if ( settings & UC_FONTS_SETTINGS_BIT_BCS_MASK ) {
-		char_byte_index = uc_fonts_bcs_get_char_index(char_code, progmem_font);
-	} else {
-		return;
-	}
+	return 0;
+}
 
-	//If char is empty, display null char
-	if ( char_code != 0 && pgm_read_byte(&progmem_font[char_byte_index]) == 0 ) char_byte_index = 3;
+/**
+ * Builds an index of the byte offsets of a range of characters in RAM and
+ * registers it, so that looking up one of these characters becomes a
+ * single table read. Walks the font once.
+ *
+ * E.g. first 32 and count 96 covers printable ASCII with 192 bytes of RAM.
+ *
+ * params:
+ * 		- progmem_font: font stored in progmem
+ * 		- offsets: array of count entries which receives the offsets, must stay valid while registered
+ * 		- first: code of first character to index
+ * 		- count: amount of characters to index (first + count <= 256)
+ *
+ * returns: 1 if the index has been registered, 0 if all UC_FONTS_INDEX_SLOTS are in use or the font is ranged (rg).
+ */
+uint8_t uc_fonts_build_index(const uint8_t *progmem_font,
+							 uint16_t *offsets,
+							 uint8_t first,
+							 uint16_t count) {
 
-	if ( pgm_read_byte(&progmem_font[char_byte_index++]) ) {
-		//Char not empty!
+	uint8_t settings = uc_fonts_get_settings(progmem_font);
+	uint16_t byte_index = 3;
 
-		uint8_t current_x = x;
-		uint8_t current_y = y;
-		uint8_t current_byte = 0;
+	if ( settings & UC_FONTS_SETTINGS_BIT_RG_MASK ) return 0;
 
-		if ( settings & UC_FONTS_SETTINGS_BIT_HV_MASK ) {
-			//Left to right, top to bottom
+	if ( settings & UC_FONTS_SETTINGS_BIT_BCS_MASK ) {
+		byte_index = uc_fonts_bcs_get_char_index(first, progmem_font);
+	}
 
-			for ( uint16_t i = 0; i < wh; i++ ) {
-				if ( i % 8 == 0 ) current_byte = pgm_read_byte(&progmem_font[char_byte_index++]);
+	for ( uint16_t i = 0; i < count; i++ ) {
+		if ( settings & UC_FONTS_SETTINGS_BIT_BCS_MASK ) {
+			offsets[i] = byte_index;
+			byte_index = uc_fonts_bcs_walk_char_index(first + i + 1, first + i, byte_index, progmem_font);
+		} else {
+			offsets[i] = uc_fonts_bc_get_char_index(first + i, progmem_font);
+		}
+	}
 
-				uint8_t pixel = current_byte & 0x01;
-				if ( pixel ) LCD_API_SET_PIXEL(current_x, current_y, 1);
-				else if ( draw_white_pixels ) LCD_API_SET_PIXEL(current_x, current_y, 0);
+	return uc_fonts_register_index(progmem_font, offsets, first, count, 0);
+}
 
-				current_byte >>= 1;
-				current_x++;
+/**
+ * Registers an offset table of all 256 characters stored in progmem,
+ * e.g. generated along with the font.
+ *
+ * params:
+ * 		- progmem_font: font stored in progmem
+ * 		- progmem_offsets: table of 256 byte offsets stored in progmem
+ *
+ * returns: 1 if the index has been registered, 0 if all UC_FONTS_INDEX_SLOTS are in use.
+ */
+uint8_t uc_fonts_register_progmem_index(const uint8_t *progmem_font, const uint16_t *progmem_offsets) {
+	return uc_fonts_register_index(progmem_font, progmem_offsets, 0, 256, 1);
+}
 
-				if ( current_x - x == width ) {
-					current_x = x;
-					current_y++;
-				}
-			}
-		} else if ( settings & UC_FONTS_SETTINGS_BIT_VH_MASK ) {
-			//Top to bottom, left to right
+/**
+ * Retrieve the index of the first character byte in a font stored in
+ * progmem. Uses a registered index if there is one for the character,
+ * otherwise the offset is calculated (bc), searched (bcs) or binary
+ * searched (rg). Codes above 255 are taken as code 0 by bc and bcs fonts.
+ *
+ * params:
+ * 		- char_code: code of character to get index for
+ * 		- progmem_font: font stored in progmem
+ *
+ * returns: index of first byte that belongs to a character (hasPixels-flag byte), 0 if the format is unknown or a ranged font has no such character.
+ */
+uint16_t uc_fonts_get_char_index(uint16_t char_code,
+								 const uint8_t *progmem_font) {
 
-			for ( uint16_t i = 0; i < wh; i++ ) {
-				if ( i % 8 == 0 ) current_byte = pgm_read_byte(&progmem_font[char_byte_index++]);
+	uint8_t settings = uc_fonts_get_settings(progmem_font);
+	if ( settings & UC_FONTS_SETTINGS_BIT_RG_MASK ) return uc_fonts_rg_get_char_index(char_code, progmem_font);
+	if ( !(settings & (UC_FONTS_SETTINGS_BIT_BC_MASK | UC_FONTS_SETTINGS_BIT_BCS_MASK)) ) return 0;
+	if ( char_code > 255 ) char_code = 0;
 
-				uint8_t pixel = current_byte & 0x01;
-				if ( pixel ) LCD_API_SET_PIXEL(current_x, current_y, 1);
-				else if ( draw_white_pixels ) LCD_API_SET_PIXEL(current_x, current_y, 0);
+	uc_fonts_index *index = uc_fonts_find_index(progmem_font);
+	if ( index ) {
+		uint16_t position = (uint16_t)(char_code - index->first);
 
-				current_byte >>= 1;
-				current_y++;
+		if ( char_code >= index->first && position < index->count ) {
+			if ( index->progmem ) return pgm_read_word(&index->offsets[position]);
+			return index->offsets[position];
+		}
 
-				if ( current_y - y == height ) {
-					current_y = y;
-					current_x++;
-				}
-			}
+		//Continue searching after the indexed range instead of from the start
+		if ( (settings & UC_FONTS_SETTINGS_BIT_BCS_MASK) && char_code >= index->first && index->count ) {
+			uint16_t last = index->first + index->count - 1;
+			uint16_t last_index = index->progmem ? pgm_read_word(&index->offsets[index->count - 1]) : index->offsets[index->count - 1];
+			return uc_fonts_bcs_walk_char_index(char_code, last, last_index, progmem_font);
 		}
 	}
+
+	if ( settings & UC_FONTS_SETTINGS_BIT_BC_MASK ) return uc_fonts_bc_get_char_index(char_code, progmem_font);
+	return uc_fonts_bcs_get_char_index(char_code, progmem_font);
 }
 
+
+struct uc_fonts_kerning_struct {
+	const uint8_t *progmem_font;	//0 if slot is free
+	const uint8_t *progmem_pairs;
+};
+
+typedef struct uc_fonts_kerning_struct uc_fonts_kerning;
+
+uc_fonts_kerning uc_fonts_kernings[UC_FONTS_KERNING_SLOTS];
+
 /**
- * Draws a series of characters.
+ * Registers a kerning table for a font. The table is stored in progmem and
+ * consists of triples: left char code, right char code and the signed
+ * amount of pixels added to the advance between them (int8_t stored as
+ * uint8_t). Triples are sorted by left char code, the table ends with a
+ * left char code of 0. Only codes up to 255 can be kerned.
  *
  * params:
- * 		- string: string to draw
- * 		- x: x coordinate to start drawing
- * 		- y: y coordinate to start drawing
- * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
- * 		- fill_char_gips: if 1, gaps between chars are overridden by white pixels
- * 		- progmem_font: font in progmem
+ * 		- progmem_font: font stored in progmem
+ * 		- progmem_pairs: kerning table stored in progmem, 0 to remove the table of the font
+ *
+ * returns: 1 if the table has been registered, 0 if all UC_FONTS_KERNING_SLOTS are in use.
  */
-void uc_fonts_draw_string(char *string,
-						  uint8_t x,
-						  uint8_t y,
-						  uint8_t draw_white_pixels,
-						  uint8_t fill_char_gaps,
-						  const uint8_t *progmem_font) {
+uint8_t uc_fonts_set_kerning(const uint8_t *progmem_font, const uint8_t *progmem_pairs) {
+	uc_fonts_kerning *free_slot = 0;
+
+	for ( uint8_t i = 0; i < UC_FONTS_KERNING_SLOTS; i++ ) {
+		if ( uc_fonts_kernings[i].progmem_font == progmem_font ) {
+			uc_fonts_kernings[i].progmem_pairs = progmem_pairs;
+			if ( !progmem_pairs ) uc_fonts_kernings[i].progmem_font = 0;
+			return 1;
+		}
+		if ( !free_slot && !uc_fonts_kernings[i].progmem_font ) free_slot = &uc_fonts_kernings[i];
+	}
 
-	uint8_t x_advance = uc_fonts_get_char_width(progmem_font) + 1;
-	uint8_t font_height = uc_fonts_get_char_height(progmem_font);
+	if ( !progmem_pairs ) return 1;
+	if ( !free_slot ) return 0;
 
-	uint8_t string_index = 0;
-	uint8_t current_x = x;
-	uint8_t current_char_code = 0;
+	free_slot->progmem_font = progmem_font;
+	free_slot->progmem_pairs = progmem_pairs;
+	return 1;
+}
 
-	while ( (current_char_code = string[string_index++]) ) {
-		if ( string_index > 1 ) { // greater than 1 because index got already incremented in while condition
-			current_x += x_advance;
-			if ( fill_char_gaps )
-				uc_graphics_draw_line_left_top_right_bottom(current_x-1, y, current_x-1, y+font_height-1, 0);
-		}
-		uc_fonts_draw_char(current_char_code, current_x, y, draw_white_pixels, progmem_font);
+/*
+ * Retrieves the kerning table of a font or 0.
+ */
+const uint8_t* uc_fonts_get_kerning_pairs(const uint8_t *progmem_font) {
+	for ( uint8_t i = 0; i < UC_FONTS_KERNING_SLOTS; i++ ) {
+		if ( uc_fonts_kernings[i].progmem_font == progmem_font ) return uc_fonts_kernings[i].progmem_pairs;
 	}
+	return 0;
 }
 
 /**
- * Draws a series of characters from progmem.
+ * Retrieves the kerning of a pair of characters.
  *
  * params:
- * 		- progmeme_string: string stored in progmem to draw
- * 		- x: x coordinate to start drawing
- * 		- y: y coordinate to start drawing
- * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
- * 		- fill_char_gips: if 1, gaps between chars are overridden by white pixels
- * 		- progmem_font: font in progmem
+ * 		- progmem_pairs: kerning table stored in progmem or 0
+ * 		- left: code of left character
+ * 		- right: code of right character
+ *
+ * returns: pixels to add to the advance of the left character.
  */
-void uc_fonts_draw_string_progmem(const char *progmem_string,
-								  uint8_t x,
-								  uint8_t y,
-								  uint8_t draw_white_pixels,
-								  uint8_t fill_char_gaps,
-								  const uint8_t *progmem_font) {
+int8_t uc_fonts_get_kerning(const uint8_t *progmem_pairs, uint16_t left, uint16_t right) {
+	if ( !progmem_pairs || left > 255 || right > 255 ) return 0;
+
+	uint8_t pair_left;
+	while ( (pair_left = pgm_read_byte(&progmem_pairs[0])) ) {
+		if ( pair_left > left ) break;
+		if ( pair_left == left && pgm_read_byte(&progmem_pairs[1]) == right ) return (int8_t)pgm_read_byte(&progmem_pairs[2]);
+		progmem_pairs += 3;
+	}
 
-	uint8_t x_advance = uc_fonts_get_char_width(progmem_font) + 1;
-	uint8_t font_height = uc_fonts_get_char_height(progmem_font);
+	return 0;
+}
 
-	uint8_t string_index = 0;
-	uint8_t current_x = x;
-	uint8_t current_char_code = 0;
+/*
+ * Retrieves the index of the first byte of the null char, which is drawn
+ * for empty and missing characters. Returns 0 if there is none.
+ */
+uint16_t uc_fonts_get_null_char_index(const uint8_t *progmem_font) {
+	uint8_t settings = uc_fonts_get_settings(progmem_font);
+	if ( settings & UC_FONTS_SETTINGS_BIT_RG_MASK ) return uc_fonts_rg_get_char_index(0, progmem_font);
+	if ( settings & (UC_FONTS_SETTINGS_BIT_BC_MASK | UC_FONTS_SETTINGS_BIT_BCS_MASK) ) return 3;
+	return 0;
+}
 
-	while ( (current_char_code = pgm_read_byte(&progmem_string[string_index++])) ) {
-		if ( string_index > 1 ) { // greater than 1 because index got already incremented in while condition
-			current_x += x_advance;
-			if ( fill_char_gaps )
-				uc_graphics_draw_line_left_top_right_bottom(current_x-1, y, current_x-1, y+font_height-1, 0);
-		}
-		uc_fonts_draw_char(current_char_code, current_x, y, draw_white_pixels, progmem_font);
+/*
+ * Retrieves the index of the first pixel byte of a character, the null
+ * char is taken for empty or missing characters. Returns 0 if there is
+ * nothing to draw (unknown format or empty null char).
+ */
+uint16_t uc_fonts_get_glyph_index(uint16_t char_code, const uint8_t *progmem_font) {
+	uint16_t char_byte_index = uc_fonts_get_char_index(char_code, progmem_font);
+
+	//If char is empty, display null char
+	if ( char_byte_index == 0 || (char_code != 0 && pgm_read_byte(&progmem_font[char_byte_index]) == 0) ) {
+		char_byte_index = uc_fonts_get_null_char_index(progmem_font);
 	}
+	if ( char_byte_index == 0 || !pgm_read_byte(&progmem_font[char_byte_index]) ) return 0;
+
+	return char_byte_index + 1;
 }
 
+struct uc_fonts_glyph_struct {
+	uint16_t bitmap_index;	//index of first pixel byte, 0 if there are no pixels to draw
+	uint8_t bitmap_width;	//width of pixels
+	int8_t bearing;			//x offset of pixels from pen position
+	uint8_t advance;		//pen movement to next character
+};
 
-/**
- * Draws a string and creates line breaks if necessary.
- *
- * params:
- * 		- text: string of characters to draw
- * 		- x: x coordinate to start drawing
- * 		- y: y coordinate to start drawing
- * 		- line_spacing: amount of pixels between lines
- * 		- max_x: last x coordinate where it is allowed to draw character pixels to
- * 		- max_y: last y coordinate where it is allowed to draw character pixels to
- * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only the black ones
- * 		- fill_gaps: if 1, gaps between characters and lines will be filled with white pixels
- * 		- progmem_font: font stored in progmem
- */
-void uc_fonts_draw_text(char *text,
-						uint8_t x,
-						uint8_t y,
-						uint8_t line_spacing,
-						uint8_t max_x,
-						uint8_t max_y,
-						uint8_t draw_white_pixels,
-						uint8_t fill_char_gaps,
-						const uint8_t *progmem_font) {
+typedef struct uc_fonts_glyph_struct uc_fonts_glyph;
 
-	uint8_t font_width = uc_fonts_get_char_width(progmem_font);
-	uint8_t font_height = uc_fonts_get_char_height(progmem_font);
+#if UC_FONTS_GLYPH_CACHE_SLOTS > 0
+struct uc_fonts_glyph_cache_entry_struct {
+	const uint8_t *progmem_font;	//0 if slot is free
+	uint16_t char_code;
+	uc_fonts_glyph glyph;
+	uint8_t columns[UC_FONTS_MAX_GLYPH_BYTES];	//bitmap decoded into page bytes
+};
 
-	uint8_t x_advance = font_width + 1;
-	uint8_t x_advance_plus_width_minus_one = x_advance+font_width-1;
-	uint8_t y_advance = font_height + line_spacing;
-	uint8_t y_advance_plus_width_minus_one = y_advance+font_height-1;
+typedef struct uc_fonts_glyph_cache_entry_struct uc_fonts_glyph_cache_entry;
 
-	uint8_t string_index = 0;
-	uint8_t current_x = x;
-	uint8_t current_y = y;
-	uint8_t current_char_code = 0;
-	uint8_t line_beginning = 1;
+uc_fonts_glyph_cache_entry uc_fonts_glyph_cache[UC_FONTS_GLYPH_CACHE_SLOTS];
+uint16_t uc_fonts_glyph_cache_hits = 0;
+uint16_t uc_fonts_glyph_cache_misses = 0;
 
-	if ( x+font_width-1 > max_x ) return;
-	if ( y+font_height-1 > max_y ) return;
+/*
+ * Retrieves the cache slot a character of a font is stored in.
+ */
+uc_fonts_glyph_cache_entry* uc_fonts_get_glyph_cache_slot(uint16_t char_code, const uint8_t *progmem_font) {
+	return &uc_fonts_glyph_cache[(uint8_t)(char_code ^ (char_code >> 8) ^ (uint8_t)(uintptr_t)progmem_font) % UC_FONTS_GLYPH_CACHE_SLOTS];
+}
 
-	while ( (current_char_code = text[string_index++]) ) {
-		if ( !line_beginning && fill_char_gaps ) {
-			uc_graphics_draw_line_left_top_right_bottom(current_x-1, current_y, current_x-1, current_y+font_height-1, 0);
-		}
-		line_beginning = 0;
+/**
+ * Empties the glyph cache and resets its counters.
+ */
+void uc_fonts_reset_glyph_cache() {
+	for ( uint8_t i = 0; i < UC_FONTS_GLYPH_CACHE_SLOTS; i++ ) {
+		uc_fonts_glyph_cache[i].progmem_font = 0;
+	}
+	uc_fonts_glyph_cache_hits = 0;
+	uc_fonts_glyph_cache_misses = 0;
+}
+#endif
 
-		uc_fonts_draw_char(current_char_code, current_x, current_y, draw_white_pixels, progmem_font);
+/**
+ * Looks up the metrics and pixels of a character. Fixed width fonts have
+ * a bearing of 0 and advance by the character width plus one pixel gap.
+ *
+ * Characters of proportional fonts (pr) start with their advance (0 for
+ * empty characters, which are stored as this single byte), followed by
+ * bitmap width, bearing (int8_t) and the pixel bytes of a bitmap of
+ * bitmap width and font height.
+ *
+ * params:
+ * 		- char_code: code of character
+ * 		- progmem_font: font in progmem
+ * 		- glyph: receives metrics and index of pixels
+ */
+void uc_fonts_get_glyph(uint16_t char_code, const uint8_t *progmem_font, uc_fonts_glyph *glyph) {
+	#if UC_FONTS_GLYPH_CACHE_SLOTS > 0
+		uc_fonts_glyph_cache_entry *entry = uc_fonts_get_glyph_cache_slot(char_code, progmem_font);
+		if ( entry->progmem_font == progmem_font && entry->char_code == char_code ) {
+			*glyph = entry->glyph;
+			return;
+		}
+	#endif
 
-		if ( current_x + x_advance_plus_width_minus_one > max_x ) {
-			if ( current_y + y_advance_plus_width_minus_one > max_y ) {
-				break;
-			} else {
+	uint8_t settings = pgm_read_byte(&progmem_font[0]);
 
+	if ( settings & UC_FONTS_SETTINGS_BIT_PR_MASK ) {
+		glyph->bitmap_index = 0;
+		glyph->bitmap_width = 0;
+		glyph->bearing = 0;
+		glyph->advance = 0;
 
-				if ( fill_char_gaps ) {
-					uc_graphics_fill_rect(x, current_y+font_height, current_x+font_width-x, line_spacing, 0);
-				}
+		uint16_t char_byte_index = uc_fonts_get_char_index(char_code, progmem_font);
 
-				current_x = x;
-				current_y += y_advance;
-				line_beginning = 1;
+		//If char is empty or missing, display null char, but keep an empty space blank
+		if ( char_byte_index == 0 || pgm_read_byte(&progmem_font[char_byte_index]) == 0 ) {
+			if ( char_code == 32 ) {
+				glyph->advance = pgm_read_byte(&progmem_font[1]) + 1;
+				return;
 			}
-		} else {
-			current_x += x_advance;
+			char_byte_index = uc_fonts_get_null_char_index(progmem_font);
+			if ( char_byte_index == 0 ) return;
 		}
+
+		glyph->advance = pgm_read_byte(&progmem_font[char_byte_index]);
+		if ( glyph->advance == 0 ) return;
+
+		glyph->bitmap_width = pgm_read_byte(&progmem_font[char_byte_index + 1]);
+		glyph->bearing = (int8_t)pgm_read_byte(&progmem_font[char_byte_index + 2]);
+		if ( glyph->bitmap_width ) glyph->bitmap_index = char_byte_index + 3;
+		return;
 	}
+
+	glyph->bitmap_width = pgm_read_byte(&progmem_font[1]);
+	glyph->bearing = 0;
+	glyph->advance = glyph->bitmap_width + 1;
+	glyph->bitmap_index = (char_code == 32) ? 0 : uc_fonts_get_glyph_index(char_code, progmem_font);
 }
 
 /**
- * Draws a string stored in progmem and creates line breaks if necessary.
+ * Reads a character of a string and moves string_index to the next one.
+ * Strings for ranged fonts (rg) are decoded as UTF-8, invalid sequences
+ * and code points above 0xFFFF are read as 0xFFFD (replacement character).
+ * Other fonts take every byte as one character.
  *
  * params:
- * 		- progmem_text: string of characters stored in progmem to draw
- * 		- x: x coordinate to start drawing
- * 		- y: y coordinate to start drawing
- * 		- line_spacing: amount of pixels between lines
- * 		- max_x: last x coordinate where it is allowed to draw character pixels to
- * 		- max_y: last y coordinate where it is allowed to draw character pixels to
- * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only the black ones
- * 		- fill_gaps: if 1, gaps between characters and lines will be filled with white pixels
- * 		- progmem_font: font stored in progmem
+ * 		- string: string in RAM or progmem
+ * 		- progmem: 1 if string is stored in progmem
+ * 		- utf8: 1 if the string has to be decoded as UTF-8
+ * 		- string_index: index of first byte of character, receives index of next character
+ *
+ * returns: code of character, 0 at the end of the string.
  */
-void uc_fonts_draw_text_progmem(const char *progmem_text,
-								uint8_t x,
-								uint8_t y,
-								uint8_t line_spacing,
-								uint8_t max_x,
-								uint8_t max_y,
-								uint8_t draw_white_pixels,
-								uint8_t fill_char_gaps,
-								const uint8_t *progmem_font) {
+uint16_t uc_fonts_read_char(const char *string, uint8_t progmem, uint8_t utf8, uint8_t *string_index) {
+	uint8_t current_byte = progmem ? pgm_read_byte(&string[*string_index]) : string[*string_index];
+	if ( current_byte == 0 ) return 0;
+
+	(*string_index)++;
+	if ( !utf8 || current_byte < 0x80 ) return current_byte;
+
+	uint8_t following_bytes;
+	uint16_t char_code;
+
+	if ( (current_byte & 0xE0) == 0xC0 ) {
+		following_bytes = 1;
+		char_code = current_byte & 0x1F;
+	} else if ( (current_byte & 0xF0) == 0xE0 ) {
+		following_bytes = 2;
+		char_code = current_byte & 0x0F;
+	} else {
+		//Skip the rest of an unsupported sequence
+		while ( ((progmem ? pgm_read_byte(&string[*string_index]) : string[*string_index]) & 0xC0) == 0x80 ) (*string_index)++;
+		return 0xFFFD;
+	}
 
-	uint8_t font_width = uc_fonts_get_char_width(progmem_font);
-	uint8_t font_height = uc_fonts_get_char_height(progmem_font);
+	while ( following_bytes-- ) {
+		current_byte = progmem ? pgm_read_byte(&string[*string_index]) : string[*string_index];
+		if ( (current_byte & 0xC0) != 0x80 ) return 0xFFFD;
 
-	uint8_t x_advance = font_width + 1;
-	uint8_t x_advance_plus_width_minus_one = x_advance+font_width-1;
-	uint8_t y_advance = font_height + line_spacing;
-	uint8_t y_advance_plus_width_minus_one = y_advance+font_height-1;
+		char_code = (char_code << 6) | (current_byte & 0x3F);
+		(*string_index)++;
+	}
+
+	return char_code;
+}
 
+/*
+ * Measures up to length bytes of a string from RAM or progmem without
+ * drawing. Stops at the terminating zero or before the first character
+ * whose pixels would end right of max_width. Width receives the extent of
+ * the pixels from the start position. Returns the amount of bytes of the
+ * measured characters.
+ */
+uint8_t uc_fonts_measure_chars(const char *string,
+							   uint8_t progmem,
+							   uint8_t length,
+							   uint16_t max_width,
+							   const uint8_t *progmem_font,
+							   uint16_t *width) {
+
+	const uint8_t *progmem_pairs = uc_fonts_get_kerning_pairs(progmem_font);
+	uint8_t utf8 = uc_fonts_get_settings(progmem_font) & UC_FONTS_SETTINGS_BIT_RG_MASK;
+
+	int16_t current_x = 0;
+	int16_t right_x = 0;
+	uint16_t previous_char_code = 0;
 	uint8_t string_index = 0;
+	uint8_t next_index = 0;
+	uint16_t current_char_code = 0;
+
+	while ( string_index < length && (current_char_code = uc_fonts_read_char(string, progmem, utf8, &next_index)) ) {
+		uc_fonts_glyph glyph;
+		uc_fonts_get_glyph(current_char_code, progmem_font, &glyph);
+
+		if ( string_index > 0 ) current_x += uc_fonts_get_kerning(progmem_pairs, previous_char_code, current_char_code);
+
+		int16_t char_right_x = current_x + glyph.bearing + glyph.bitmap_width;
+		if ( char_right_x > 0 && (uint16_t)char_right_x > max_width ) break;
+		if ( char_right_x > right_x ) right_x = char_right_x;
+
+		previous_char_code = current_char_code;
+		current_x += glyph.advance;
+		string_index = next_index;
+	}
+
+	*width = right_x;
+	return string_index;
+}
+
+/**
+ * Calculates the width of a string without drawing it, e.g. to right align
+ * or center it.
+ *
+ * params:
+ * 		- string: string to measure
+ * 		- progmem_font: font in progmem
+ *
+ * returns: amount of pixel columns uc_fonts_draw_string() would draw to.
+ */
+uint16_t uc_fonts_get_string_width(char *string, const uint8_t *progmem_font) {
+	uint16_t width;
+	uc_fonts_measure_chars(string, 0, 255, 0xFFFF, progmem_font, &width);
+	return width;
+}
+
+/**
+ * Calculates the width of a string stored in progmem without drawing it.
+ *
+ * params:
+ * 		- progmem_string: string stored in progmem to measure
+ * 		- progmem_font: font in progmem
+ *
+ * returns: amount of pixel columns uc_fonts_draw_string_progmem() would draw to.
+ */
+uint16_t uc_fonts_get_string_width_progmem(const char *progmem_string, const uint8_t *progmem_font) {
+	uint16_t width;
+	uc_fonts_measure_chars(progmem_string, 1, 255, 0xFFFF, progmem_font, &width);
+	return width;
+}
+
+/**
+ * Finds the line break of a text the way uc_fonts_draw_text() breaks it:
+ * a line holds as many characters as fit into max_width.
+ *
+ * params:
+ * 		- text: text to measure, start of the line
+ * 		- max_width: width available for the line in pixels
+ * 		- progmem_font: font in progmem
+ * 		- line_width: receives the width of the line in pixels
+ *
+ * returns: amount of characters of the line, the next line starts at text + amount.
+ * 			0 if the text ends or its first character does not fit.
+ */
+uint8_t uc_fonts_get_line_break(char *text, uint16_t max_width, const uint8_t *progmem_font, uint16_t *line_width) {
+	return uc_fonts_measure_chars(text, 0, 255, max_width, progmem_font, line_width);
+}
+
+/**
+ * Finds the line break of a text stored in progmem, see
+ * uc_fonts_get_line_break().
+ *
+ * params:
+ * 		- progmem_text: text stored in progmem to measure, start of the line
+ * 		- max_width: width available for the line in pixels
+ * 		- progmem_font: font in progmem
+ * 		- line_width: receives the width of the line in pixels
+ *
+ * returns: amount of characters of the line, the next line starts at progmem_text + amount.
+ * 			0 if the text ends or its first character does not fit.
+ */
+uint8_t uc_fonts_get_line_break_progmem(const char *progmem_text, uint16_t max_width, const uint8_t *progmem_font, uint16_t *line_width) {
+	return uc_fonts_measure_chars(progmem_text, 1, 255, max_width, progmem_font, line_width);
+}
+
+struct uc_fonts_text_extent_struct {
+	uint16_t width;			//width of the widest line
+	uint16_t height;		//height from top of first line to bottom of last line
+	uint8_t lines;			//amount of lines
+	uint16_t length;		//amount of characters which fit into the box
+};
+
+typedef struct uc_fonts_text_extent_struct uc_fonts_text_extent;
+
+/*
+ * Measures a text from RAM or progmem the way uc_fonts_draw_text() lays it
+ * out.
+ */
+void uc_fonts_measure_text_chars(const char *text,
+								 uint8_t progmem,
+								 uint8_t line_spacing,
+								 uint16_t max_width,
+								 uint16_t max_height,
+								 const uint8_t *progmem_font,
+								 uc_fonts_text_extent *extent) {
+
+	uint8_t font_height = uc_fonts_get_char_height(progmem_font);
+
+	extent->width = 0;
+	extent->height = 0;
+	extent->lines = 0;
+	extent->length = 0;
+
+	uint16_t current_y = 0;
+
+	while ( current_y + font_height <= max_height ) {
+		uint16_t line_width;
+		uint8_t line_length = uc_fonts_measure_chars(text, progmem, 255, max_width, progmem_font, &line_width);
+		if ( line_length == 0 ) break;
+
+		if ( line_width > extent->width ) extent->width = line_width;
+		extent->height = current_y + font_height;
+		extent->lines++;
+		extent->length += line_length;
+
+		text += line_length;
+		current_y += font_height + line_spacing;
+	}
+}
+
+/**
+ * Measures the block a text takes when drawn with uc_fonts_draw_text(),
+ * without drawing it. The layout can be computed once, e.g. to center a
+ * text or to skip drawing it if it is outside of a region to update.
+ *
+ * params:
+ * 		- text: text to measure
+ * 		- line_spacing: amount of pixels between lines
+ * 		- max_width: width of the box in pixels
+ * 		- max_height: height of the box in pixels
+ * 		- progmem_font: font in progmem
+ * 		- extent: receives width, height, lines and amount of characters which fit into the box
+ */
+void uc_fonts_measure_text(char *text,
+						   uint8_t line_spacing,
+						   uint16_t max_width,
+						   uint16_t max_height,
+						   const uint8_t *progmem_font,
+						   uc_fonts_text_extent *extent) {
+
+	uc_fonts_measure_text_chars(text, 0, line_spacing, max_width, max_height, progmem_font, extent);
+}
+
+/**
+ * Measures the block a text stored in progmem takes when drawn with
+ * uc_fonts_draw_text_progmem(), without drawing it.
+ *
+ * params:
+ * 		- progmem_text: text stored in progmem to measure
+ * 		- line_spacing: amount of pixels between lines
+ * 		- max_width: width of the box in pixels
+ * 		- max_height: height of the box in pixels
+ * 		- progmem_font: font in progmem
+ * 		- extent: receives width, height, lines and amount of characters which fit into the box
+ */
+void uc_fonts_measure_text_progmem(const char *progmem_text,
+								   uint8_t line_spacing,
+								   uint16_t max_width,
+								   uint16_t max_height,
+								   const uint8_t *progmem_font,
+								   uc_fonts_text_extent *extent) {
+
+	uc_fonts_measure_text_chars(progmem_text, 1, line_spacing, max_width, max_height, progmem_font, extent);
+}
+
+/**
+ * Decodes pixel bytes of a font into page layout: (height+7)/8 rows of
+ * width bytes, every byte holds 8 vertical pixels of a column (LSB is the
+ * top pixel), as taken by LCD_API_BLIT.
+ *
+ * params:
+ * 		- progmem_bits: pixel bytes stored in progmem
+ * 		- settings: settings byte of font (bit order)
+ * 		- width: width of bitmap
+ * 		- height: height of bitmap
+ * 		- columns: receives width * ((height+7)/8) bytes
+ */
+void uc_fonts_decode_bitmap(const uint8_t *progmem_bits,
+							uint8_t settings,
+							uint8_t width,
+							uint8_t height,
+							uint8_t *columns) {
+
+	if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) {
+		memcpy_P(columns, progmem_bits, width * ((height + 7)/8));
+		return;
+	}
+
+	memset(columns, 0, width * ((height + 7)/8));
+
+	//Bits are read byte wise: a run ends at the end of a byte or of a row
+	//(hv) / column (vh), zero runs are skipped as a whole
+	uint16_t bit_index = 0;
+
+	if ( settings & UC_FONTS_SETTINGS_BIT_HV_MASK ) {
+		//Left to right, top to bottom
+		for ( uint8_t row = 0; row < height; row++ ) {
+			uint8_t *page_byte = &columns[(row/8) * width];
+			uint8_t row_bit = 1 << (row%8);
+			uint8_t column = 0;
+
+			while ( column < width ) {
+				uint8_t bits = pgm_read_byte(&progmem_bits[bit_index/8]) >> (bit_index%8);
+				uint8_t count = 8 - (bit_index%8);
+				if ( count > width - column ) count = width - column;
+				uint8_t end = column + count;
+				bit_index += count;
+
+				for ( ; bits && column < end; column++ ) {
+					if ( bits & 0x01 ) page_byte[column] |= row_bit;
+					bits >>= 1;
+				}
+				column = end;
+			}
+		}
+	} else if ( settings & UC_FONTS_SETTINGS_BIT_VH_MASK ) {
+		//Top to bottom, left to right
+		for ( uint8_t column = 0; column < width; column++ ) {
+			uint8_t row = 0;
+
+			while ( row < height ) {
+				uint8_t bits = pgm_read_byte(&progmem_bits[bit_index/8]) >> (bit_index%8);
+				uint8_t count = 8 - (bit_index%8);
+				if ( count > height - row ) count = height - row;
+				uint8_t end = row + count;
+				bit_index += count;
+
+				for ( ; bits && row < end; row++ ) {
+					if ( bits & 0x01 ) columns[(row/8) * width + column] |= (1 << (row%8));
+					bits >>= 1;
+				}
+				row = end;
+			}
+		}
+	}
+}
+
+/**
+ * Decodes a character into page layout, see uc_fonts_decode_bitmap. The
+ * bitmap is as wide as the glyph bitmap (uc_fonts_get_glyph).
+ *
+ * params:
+ * 		- char_code: code of character
+ * 		- progmem_font: font in progmem
+ * 		- columns: receives bitmap width * ((height+7)/8) bytes
+ *
+ * returns: 1 if the character has to be drawn, 0 if it is empty (nothing to draw).
+ */
+uint8_t uc_fonts_decode_char(uint16_t char_code,
+							 const uint8_t *progmem_font,
+							 uint8_t *columns) {
+
+	uint8_t settings = pgm_read_byte(&progmem_font[0]);
+	uint8_t height = pgm_read_byte(&progmem_font[2]);
+
+	uc_fonts_glyph glyph;
+	uc_fonts_get_glyph(char_code, progmem_font, &glyph);
+
+	if ( glyph.bitmap_index == 0 ) {
+		//Space of fixed width fonts is always blank
+		if ( char_code == 32 && !(settings & UC_FONTS_SETTINGS_BIT_PR_MASK) ) {
+			memset(columns, 0, glyph.bitmap_width * ((height + 7)/8));
+			return 1;
+		}
+		return 0;
+	}
+
+	uc_fonts_decode_bitmap(&progmem_font[glyph.bitmap_index], settings, glyph.bitmap_width, height, columns);
+	return 1;
+}
+
+#if UC_FONTS_GLYPH_CACHE_SLOTS > 0
+/**
+ * Looks up a character in the glyph cache, on a miss the character is
+ * decoded into its slot.
+ *
+ * params:
+ * 		- char_code: code of character
+ * 		- progmem_font: font in progmem
+ *
+ * returns: cache entry holding metrics and decoded bitmap, 0 if the character is not cached (empty, pm or too big).
+ */
+uc_fonts_glyph_cache_entry* uc_fonts_get_cached_glyph(uint16_t char_code, const uint8_t *progmem_font) {
+	uint8_t settings = pgm_read_byte(&progmem_font[0]);
+	if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) return 0;
+
+	uc_fonts_glyph_cache_entry *entry = uc_fonts_get_glyph_cache_slot(char_code, progmem_font);
+	if ( entry->progmem_font == progmem_font && entry->char_code == char_code ) {
+		uc_fonts_glyph_cache_hits++;
+		return entry;
+	}
+
+	uc_fonts_glyph glyph;
+	uc_fonts_get_glyph(char_code, progmem_font, &glyph);
+
+	uint8_t height = pgm_read_byte(&progmem_font[2]);
+	if ( glyph.bitmap_index == 0 || glyph.bitmap_width * ((height + 7)/8) > UC_FONTS_MAX_GLYPH_BYTES ) return 0;
+
+	uc_fonts_glyph_cache_misses++;
+
+	entry->progmem_font = progmem_font;
+	entry->char_code = char_code;
+	entry->glyph = glyph;
+	uc_fonts_decode_bitmap(&progmem_font[glyph.bitmap_index], settings, glyph.bitmap_width, height, entry->columns);
+
+	return entry;
+}
+#endif
+
+/*
+ * Draws pixel bytes of a font, byte wise if the LCD offers LCD_API_BLIT,
+ * otherwise pixel by pixel.
+ */
+void uc_fonts_draw_bitmap(uint8_t x,
+						  uint8_t y,
+						  uint8_t width,
+						  uint8_t height,
+						  uint8_t settings,
+						  const uint8_t *progmem_bits,
+						  uint8_t draw_white_pixels) {
+
+	#ifdef LCD_API_FAST_BLIT
+	if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) {
+		//Straight from flash, no decoding
+		LCD_API_BLIT(x, y, width, height, progmem_bits, draw_white_pixels ? 0 : progmem_bits, 1);
+		return;
+	}
+
+	if ( width * ((height + 7)/8) <= UC_FONTS_MAX_GLYPH_BYTES ) {
+		uint8_t columns[UC_FONTS_MAX_GLYPH_BYTES];
+		uc_fonts_decode_bitmap(progmem_bits, settings, width, height, columns);
+
+		//Without white pixels the glyph is its own mask
+		LCD_API_BLIT(x, y, width, height, columns, draw_white_pixels ? 0 : columns, 0);
+		return;
+	}
+	#endif
+
+	uint16_t wh = width * height;
+	uint16_t byte_index = 0;
 	uint8_t current_x = x;
 	uint8_t current_y = y;
-	uint8_t current_char_code = 0;
-	uint8_t line_beginning = 1;
+	uint8_t current_byte = 0;
 
-	if ( x+font_width-1 > max_x ) return;
-	if ( y+font_height-1 > max_y ) return;
+	if ( settings & UC_FONTS_SETTINGS_BIT_HV_MASK ) {
+		//Left to right, top to bottom
+
+		for ( uint16_t i = 0; i < wh; i++ ) {
+			if ( i % 8 == 0 ) current_byte = pgm_read_byte(&progmem_bits[byte_index++]);
+
+			uint8_t pixel = current_byte & 0x01;
+			if ( pixel ) LCD_API_SET_PIXEL(current_x, current_y, 1);
+			else if ( draw_white_pixels ) LCD_API_SET_PIXEL(current_x, current_y, 0);
+
+			current_byte >>= 1;
+			current_x++;
 
-	while ( (current_char_code = pgm_read_byte(&progmem_text[string_index++])) ) {
-		if ( !line_beginning && fill_char_gaps ) {
-			uc_graphics_draw_line_left_top_right_bottom(current_x-1, current_y, current_x-1, current_y+font_height-1, 0);
+			if ( (uint8_t)(current_x - x) == width ) {
+				current_x = x;
+				current_y++;
+			}
 		}
-		line_beginning = 0;
+	} else if ( settings & UC_FONTS_SETTINGS_BIT_VH_MASK ) {
+		//Top to bottom, left to right
 
-		uc_fonts_draw_char(current_char_code, current_x, current_y, draw_white_pixels, progmem_font);
+		for ( uint16_t i = 0; i < wh; i++ ) {
+			if ( i % 8 == 0 ) current_byte = pgm_read_byte(&progmem_bits[byte_index++]);
 
-		if ( current_x + x_advance_plus_width_minus_one > max_x ) {
-			if ( current_y + y_advance_plus_width_minus_one > max_y ) {
-				break;
-			} else {
+			uint8_t pixel = current_byte & 0x01;
+			if ( pixel ) LCD_API_SET_PIXEL(current_x, current_y, 1);
+			else if ( draw_white_pixels ) LCD_API_SET_PIXEL(current_x, current_y, 0);
 
+			current_byte >>= 1;
+			current_y++;
 
-				if ( fill_char_gaps ) {
-					uc_graphics_fill_rect(x, current_y+font_height, current_x+font_width-x, line_spacing, 0);
-				}
+			if ( (uint8_t)(current_y - y) == height ) {
+				current_y = y;
+				current_x++;
+			}
+		}
+	} else if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) {
+		//Page bytes
+		for ( uint8_t row = 0; row < height; row++ ) {
+			uint16_t page_index = (row/8) * width;
+
+			for ( uint8_t column = 0; column < width; column++ ) {
+				uint8_t pixel = (pgm_read_byte(&progmem_bits[page_index + column]) >> (row%8)) & 0x01;
+				if ( pixel ) LCD_API_SET_PIXEL(x + column, y + row, 1);
+				else if ( draw_white_pixels ) LCD_API_SET_PIXEL(x + column, y + row, 0);
+			}
+		}
+	}
+}
 
-				current_x = x;
-				current_y += y_advance;
-				line_beginning = 1;
+/*
+ * Draws a character. known_glyph is its glyph if the caller looked it up
+ * already, otherwise 0 (it is only looked up if the cache misses).
+ */
+void uc_fonts_draw_glyph(uint16_t char_code,
+						 const uc_fonts_glyph *known_glyph,
+						 uint8_t x,
+						 uint8_t y,
+						 uint8_t draw_white_pixels,
+						 const uint8_t *progmem_font) {
+
+	uint8_t settings = pgm_read_byte(&progmem_font[0]);
+	uint8_t height = pgm_read_byte(&progmem_font[2]);
+
+	#if defined(LCD_API_FAST_BLIT) && UC_FONTS_GLYPH_CACHE_SLOTS > 0
+		uc_fonts_glyph_cache_entry *entry = uc_fonts_get_cached_glyph(char_code, progmem_font);
+		if ( entry ) {
+			LCD_API_BLIT(x + entry->glyph.bearing, y, entry->glyph.bitmap_width, height, entry->columns, draw_white_pixels ? 0 : entry->columns, 0);
+			return;
+		}
+	#endif
+
+	uc_fonts_glyph glyph;
+	if ( known_glyph ) glyph = *known_glyph;
+	else uc_fonts_get_glyph(char_code, progmem_font, &glyph);
+
+	if ( glyph.bitmap_index == 0 ) {
+		//Space of fixed width fonts clears its cell
+		if ( char_code == 32 && draw_white_pixels && !(settings & UC_FONTS_SETTINGS_BIT_PR_MASK) ) {
+			uc_graphics_fill_rect(x, y, glyph.bitmap_width, height, 0);
+		}
+		return;
+	}
+
+	uc_fonts_draw_bitmap(x + glyph.bearing, y, glyph.bitmap_width, height, settings, &progmem_font[glyph.bitmap_index], draw_white_pixels);
+}
+
+/**
+ * Draws a font.
+ *
+ * params:
+ * 		- char_code: code of character
+ * 		- x: x coordinate of pen position (left edge of fixed width characters)
+ * 		- y: y coordinate to start drawing
+ * 		- draw_white_pixels: if 1, also white pixels will be drawn, if 0 only black pixels will be drawn
+ * 		- progmem_font: font in progmem
+ */
+void uc_fonts_draw_char(uint16_t char_code,
+						uint8_t x,
+						uint8_t y,
+						uint8_t draw_white_pixels,
+						const uint8_t *progmem_font) {
+
+	uc_fonts_draw_glyph(char_code, 0, x, y, draw_white_pixels, progmem_font);
+}
+
+//Nibble of a page byte stretched to 4 * scale bits, for scale 2, 3 and 4
+const uint16_t uc_fonts_scale_tables[3][16] PROGMEM = {
+	{0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF},
+	{0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF},
+	{0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF}
+};
+
+/*
+ * Reads a pixel of the pixel bytes of a character (hv, vh or pm).
+ */
+uint8_t uc_fonts_get_bitmap_pixel(const uint8_t *progmem_bits,
+								  uint8_t settings,
+								  uint8_t width,
+								  uint8_t height,
+								  uint8_t x,
+								  uint8_t y) {
+
+	if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) return (pgm_read_byte(&progmem_bits[(y/8) * width + x]) >> (y%8)) & 0x01;
+
+	uint16_t i = (settings & UC_FONTS_SETTINGS_BIT_HV_MASK) ? (uint16_t)y * width + x : (uint16_t)x * height + y;
+	return (pgm_read_byte(&progmem_bits[i/8]) >> (i%8)) & 0x01;
+}
+
+/**
+ * Draws a character scaled by an integer factor, see file header.
+ *
+ * params:
+ * 		- char_code: code of character
+ * 		- x: x coordinate of pen position (left edge of fixed width characters)
+ * 		- y: y coordinate to start drawing
+ * 		- scale: 1 to 4, every pixel is drawn as scale x scale block
+ * 		- draw_white_pixels: if 1, also white pixels will be drawn, if 0 only black pixels will be drawn
+ * 		- progmem_font: font in progmem
+ */
+void uc_fonts_draw_char_scaled(uint16_t char_code,
+							   uint8_t x,
+							   uint8_t y,
+							   uint8_t scale,
+							   uint8_t draw_white_pixels,
+							   const uint8_t *progmem_font) {
+
+	if ( scale < 2 ) {
+		uc_fonts_draw_char(char_code, x, y, draw_white_pixels, progmem_font);
+		return;
+	}
+	if ( scale > 4 ) scale = 4;
+
+	uint8_t settings = pgm_read_byte(&progmem_font[0]);
+	uint8_t height = pgm_read_byte(&progmem_font[2]);
+
+	uc_fonts_glyph glyph;
+	uc_fonts_get_glyph(char_code, progmem_font, &glyph);
+
+	uint8_t width = glyph.bitmap_width;
+
+	if ( glyph.bitmap_index == 0 ) {
+		//Space of fixed width fonts clears its cell
+		if ( char_code == 32 && draw_white_pixels && !(settings & UC_FONTS_SETTINGS_BIT_PR_MASK) ) {
+			uc_graphics_fill_rect(x, y, width * scale, height * scale, 0);
+		}
+		return;
+	}
+
+	const uint8_t *progmem_bits = &progmem_font[glyph.bitmap_index];
+	x += glyph.bearing * scale;
+
+	#ifdef LCD_API_FAST_BLIT
+	uint8_t pages = (height + 7)/8;
+	uint8_t scaled_width = width * scale;
+
+	if ( width * pages <= UC_FONTS_MAX_GLYPH_BYTES && (uint16_t)scaled_width * pages * scale <= UC_FONTS_MAX_SCALED_GLYPH_BYTES ) {
+		uint8_t columns[UC_FONTS_MAX_GLYPH_BYTES];
+		uint8_t scaled[UC_FONTS_MAX_SCALED_GLYPH_BYTES];
+		const uint16_t *progmem_table = uc_fonts_scale_tables[scale - 2];
+
+		uc_fonts_decode_bitmap(progmem_bits, settings, width, height, columns);
+
+		//Every page byte becomes scale page bytes of scale columns
+		for ( uint8_t page = 0; page < pages; page++ ) {
+			for ( uint8_t column = 0; column < width; column++ ) {
+				uint8_t source = columns[page * width + column];
+				uint32_t bits = pgm_read_word(&progmem_table[source & 0x0F]) | ((uint32_t)pgm_read_word(&progmem_table[source >> 4]) << (4 * scale));
+				uint8_t *target = &scaled[page * scale * scaled_width + column * scale];
+
+				for ( uint8_t i = 0; i < scale; i++ ) {
+					memset(target, (uint8_t)bits, scale);
+					bits >>= 8;
+					target += scaled_width;
+				}
 			}
-		} else {
-			current_x += x_advance;
 		}
+
+		LCD_API_BLIT(x, y, scaled_width, height * scale, scaled, draw_white_pixels ? 0 : scaled, 0);
+		return;
+	}
+	#endif
+
+	for ( uint8_t row = 0; row < height; row++ ) {
+		for ( uint8_t column = 0; column < width; column++ ) {
+			uint8_t pixel = uc_fonts_get_bitmap_pixel(progmem_bits, settings, width, height, column, row);
+			if ( pixel || draw_white_pixels ) uc_graphics_fill_rect(x + column * scale, y + row * scale, scale, scale, pixel);
+		}
+	}
+}
+
+/*
+ * Draws up to length bytes of a string from RAM or progmem, applying the
+ * metrics and kerning of the font. All metrics are multiplied by scale.
+ */
+void uc_fonts_draw_chars(const char *string,
+						 uint8_t progmem,
+						 uint8_t length,
+						 uint8_t x,
+						 uint8_t y,
+						 uint8_t scale,
+						 uint8_t draw_white_pixels,
+						 uint8_t fill_char_gaps,
+						 const uint8_t *progmem_font) {
+
+	uint8_t font_height = uc_fonts_get_char_height(progmem_font) * scale;
+	const uint8_t *progmem_pairs = uc_fonts_get_kerning_pairs(progmem_font);
+	uint8_t utf8 = uc_fonts_get_settings(progmem_font) & UC_FONTS_SETTINGS_BIT_RG_MASK;
+
+	uint8_t string_index = 0;
+	uint8_t next_index = 0;
+	uint8_t current_x = x;
+	uint16_t previous_char_code = 0;
+	uint8_t previous_right = x;		//first column after the pixels of the previous character
+	uint16_t current_char_code = 0;
+
+	while ( string_index < length && (current_char_code = uc_fonts_read_char(string, progmem, utf8, &next_index)) ) {
+		uc_fonts_glyph glyph;
+		uc_fonts_get_glyph(current_char_code, progmem_font, &glyph);
+
+		if ( string_index > 0 ) {
+			current_x += uc_fonts_get_kerning(progmem_pairs, previous_char_code, current_char_code) * scale;
+
+			uint8_t left = current_x + glyph.bearing * scale;
+			if ( fill_char_gaps && left > previous_right ) uc_graphics_fill_rect(previous_right, y, left - previous_right, font_height, 0);
+		}
+
+		if ( scale > 1 ) uc_fonts_draw_char_scaled(current_char_code, current_x, y, scale, draw_white_pixels, progmem_font);
+		else uc_fonts_draw_glyph(current_char_code, &glyph, current_x, y, draw_white_pixels, progmem_font);
+
+		previous_right = current_x + (glyph.bearing + glyph.bitmap_width) * scale;
+		previous_char_code = current_char_code;
+		current_x += glyph.advance * scale;
+		string_index = next_index;
 	}
 }
 
+/**
+ * Draws a series of characters.
+ *
+ * params:
+ * 		- string: string to draw
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
+ * 		- fill_char_gips: if 1, gaps between chars are overridden by white pixels
+ * 		- progmem_font: font in progmem
+ */
+void uc_fonts_draw_string(char *string,
+						  uint8_t x,
+						  uint8_t y,
+						  uint8_t draw_white_pixels,
+						  uint8_t fill_char_gaps,
+						  const uint8_t *progmem_font) {
+
+	uc_fonts_draw_chars(string, 0, 255, x, y, 1, draw_white_pixels, fill_char_gaps, progmem_font);
+}
+
+/**
+ * Draws a series of characters from progmem.
+ *
+ * params:
+ * 		- progmeme_string: string stored in progmem to draw
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
+ * 		- fill_char_gips: if 1, gaps between chars are overridden by white pixels
+ * 		- progmem_font: font in progmem
+ */
+void uc_fonts_draw_string_progmem(const char *progmem_string,
+								  uint8_t x,
+								  uint8_t y,
+								  uint8_t draw_white_pixels,
+								  uint8_t fill_char_gaps,
+								  const uint8_t *progmem_font) {
+
+	uc_fonts_draw_chars(progmem_string, 1, 255, x, y, 1, draw_white_pixels, fill_char_gaps, progmem_font);
+}
+
+/**
+ * Draws a series of characters scaled by an integer factor, e.g. for big
+ * readings.
+ *
+ * params:
+ * 		- string: string to draw
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- scale: 1 to 4, every pixel is drawn as scale x scale block
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
+ * 		- fill_char_gips: if 1, gaps between chars are overridden by white pixels
+ * 		- progmem_font: font in progmem
+ */
+void uc_fonts_draw_string_scaled(char *string,
+								 uint8_t x,
+								 uint8_t y,
+								 uint8_t scale,
+								 uint8_t draw_white_pixels,
+								 uint8_t fill_char_gaps,
+								 const uint8_t *progmem_font) {
+
+	uc_fonts_draw_chars(string, 0, 255, x, y, scale, draw_white_pixels, fill_char_gaps, progmem_font);
+}
+
+/**
+ * Draws a series of characters from progmem scaled by an integer factor.
+ *
+ * params:
+ * 		- progmem_string: string stored in progmem to draw
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- scale: 1 to 4, every pixel is drawn as scale x scale block
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
+ * 		- fill_char_gips: if 1, gaps between chars are overridden by white pixels
+ * 		- progmem_font: font in progmem
+ */
+void uc_fonts_draw_string_scaled_progmem(const char *progmem_string,
+										 uint8_t x,
+										 uint8_t y,
+										 uint8_t scale,
+										 uint8_t draw_white_pixels,
+										 uint8_t fill_char_gaps,
+										 const uint8_t *progmem_font) {
+
+	uc_fonts_draw_chars(progmem_string, 1, 255, x, y, scale, draw_white_pixels, fill_char_gaps, progmem_font);
+}
+
+
+/*
+ * Draws a text from RAM or progmem line by line, the line breaks are
+ * found by uc_fonts_measure_chars().
+ */
+void uc_fonts_draw_text_chars(const char *text,
+							  uint8_t progmem,
+							  uint8_t x,
+							  uint8_t y,
+							  uint8_t line_spacing,
+							  uint8_t max_x,
+							  uint8_t max_y,
+							  uint8_t draw_white_pixels,
+							  uint8_t fill_char_gaps,
+							  const uint8_t *progmem_font) {
+
+	uint8_t font_height = uc_fonts_get_char_height(progmem_font);
+	uint8_t y_advance = font_height + line_spacing;
+
+	if ( max_x < x ) return;
+	if ( y+font_height-1 > max_y ) return;
+
+	uint16_t max_width = (uint16_t)max_x - x + 1; //256 if the whole x range is available
+	uint8_t current_y = y;
+
+	while ( 1 ) {
+		uint16_t line_width;
+		uint8_t line_length = uc_fonts_measure_chars(text, progmem, 255, max_width, progmem_font, &line_width);
+		if ( line_length == 0 ) break;
+
+		uc_fonts_draw_chars(text, progmem, line_length, x, current_y, 1, draw_white_pixels, fill_char_gaps, progmem_font);
+		text += line_length;
+
+		if ( !(progmem ? pgm_read_byte(text) : *text) ) break;
+		if ( current_y + y_advance + font_height - 1 > max_y ) break;
+
+		if ( fill_char_gaps ) {
+			uc_graphics_fill_rect(x, current_y+font_height, line_width, line_spacing, 0);
+		}
+
+		current_y += y_advance;
+	}
+}
+
+/**
+ * Draws a string and creates line breaks if necessary.
+ *
+ * params:
+ * 		- text: string of characters to draw
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- line_spacing: amount of pixels between lines
+ * 		- max_x: last x coordinate where it is allowed to draw character pixels to
+ * 		- max_y: last y coordinate where it is allowed to draw character pixels to
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only the black ones
+ * 		- fill_gaps: if 1, gaps between characters and lines will be filled with white pixels
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_fonts_draw_text(char *text,
+						uint8_t x,
+						uint8_t y,
+						uint8_t line_spacing,
+						uint8_t max_x,
+						uint8_t max_y,
+						uint8_t draw_white_pixels,
+						uint8_t fill_char_gaps,
+						const uint8_t *progmem_font) {
+
+	uc_fonts_draw_text_chars(text, 0, x, y, line_spacing, max_x, max_y, draw_white_pixels, fill_char_gaps, progmem_font);
+}
+
+/**
+ * Draws a string stored in progmem and creates line breaks if necessary.
+ *
+ * params:
+ * 		- progmem_text: string of characters stored in progmem to draw
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- line_spacing: amount of pixels between lines
+ * 		- max_x: last x coordinate where it is allowed to draw character pixels to
+ * 		- max_y: last y coordinate where it is allowed to draw character pixels to
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only the black ones
+ * 		- fill_gaps: if 1, gaps between characters and lines will be filled with white pixels
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_fonts_draw_text_progmem(const char *progmem_text,
+								uint8_t x,
+								uint8_t y,
+								uint8_t line_spacing,
+								uint8_t max_x,
+								uint8_t max_y,
+								uint8_t draw_white_pixels,
+								uint8_t fill_char_gaps,
+								const uint8_t *progmem_font) {
+
+	uc_fonts_draw_text_chars(progmem_text, 1, x, y, line_spacing, max_x, max_y, draw_white_pixels, fill_char_gaps, progmem_font);
+}
+
 #endif
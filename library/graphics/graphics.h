@@ -25,16 +25,26 @@
 #ifndef UC_AVR_GRAPHICS_GRAPHICS_H_
 #define UC_AVR_GRAPHICS_GRAPHICS_H_
 
+#include <avr/pgmspace.h>
+
 // TODO: check if all actions perform set pixel from left to right!!! -> this can save setColumn commands MASSIVELY
 
+/*
+ * All primitives draw through LCD_API_SET_PIXEL or LCD_API_FILL_RECT, so
+ * the raster operation of the LCD (LCD_API_SET_RASTER_OP) applies to them.
+ * Pixel value 1 is the "source" pixel: with XOR a second identical draw
+ * call restores the previous content. Primitives take care of touching
+ * every pixel only once.
+ */
+
 void uc_graphics_draw_line_left_top_right_bottom(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t pixel) {
 	if ( x1 == x2 && y1 == y2 ) LCD_API_SET_PIXEL(x1, y1, pixel);
 	else if ( x1 == x2 ) {
-		for ( uint8_t y = y1; y < y2+1; y++ ) {
+		for ( uint16_t y = y1; y < y2+1; y++ ) {
 			LCD_API_SET_PIXEL(x1, y, pixel);
 		}
 	} else if ( y1 == y2 ) {
-		for ( uint8_t x = x1; x < x2+1; x++ ) {
+		for ( uint16_t x = x1; x < x2+1; x++ ) {
 			LCD_API_SET_PIXEL(x, y1, pixel);
 		}
 	} else {
@@ -59,11 +69,11 @@ void uc_graphics_draw_line_left_top_right_bottom(uint8_t x1, uint8_t y1, uint8_t
 void uc_graphics_draw_line_left_bottom_right_top(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t pixel) {
 	if ( x1 == x2 && y1 == y2 ) LCD_API_SET_PIXEL(x1, y1, pixel);
 	else if ( x1 == x2 ) {
-		for ( uint8_t y = y2; y < y1+1; y++ ) {
+		for ( uint16_t y = y2; y < y1+1; y++ ) {
 			LCD_API_SET_PIXEL(x1, y, pixel);
 		}
 	} else if ( y1 == y2 ) {
-		for ( uint8_t x = x1; x < x2+1; x++ ) {
+		for ( uint16_t x = x1; x < x2+1; x++ ) {
 			LCD_API_SET_PIXEL(x, y1, pixel);
 		}
 	} else {
@@ -120,13 +130,15 @@ void uc_graphics_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
 		uint8_t right_x = x+width-1;
 		uint8_t bottom_y = y+height-1;
 
+		//Every pixel is touched exactly once, otherwise XOR raster operations
+		//would toggle the corners twice.
 		for ( uint8_t i = 0; i < width; i++ ) {
 			LCD_API_SET_PIXEL(x+i, y, pixel);
 		}
-		for ( uint8_t i = 0; i < height; i++ ) {
+		for ( uint8_t i = 1; i < height-1; i++ ) {
 			LCD_API_SET_PIXEL(x, y+i, pixel);
 		}
-		for ( uint8_t i = 0; i < height; i++ ) {
+		for ( uint8_t i = 1; i < height-1; i++ ) {
 			LCD_API_SET_PIXEL(right_x, y+i, pixel);
 		}
 		for ( uint8_t i = 0; i < width; i++ ) {
@@ -146,6 +158,9 @@ void uc_graphics_draw_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
 }
 
 void uc_graphics_fill_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t pixel) {
+	#ifdef LCD_API_FILL_RECT
+		LCD_API_FILL_RECT(x, y, width, height, pixel);
+	#else
 	if ( width > 1 && height > 1 ) {
 		for ( uint8_t j = 0; j < height; j++ ) {
 			for ( uint8_t i = 0; i < width; i++ ) {
@@ -163,6 +178,661 @@ void uc_graphics_fill_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
 	} else if ( width == 1 && height == 1 ) {
 		LCD_API_SET_PIXEL(x, y, pixel);
 	}
+	#endif
+}
+
+#ifdef LCD_API_SET_RASTER_OP
+/**
+ * Toggles all pixels of a rectangle in one pass, e.g. to highlight a
+ * selection or let a cursor blink. Calling it twice restores the
+ * original content. The raster operation set before is kept.
+ *
+ * params:
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of rectangle
+ * 		- height: height of rectangle
+ */
+void uc_graphics_invert_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+	uint8_t previous_op = LCD_API_GET_RASTER_OP();
+
+	LCD_API_SET_RASTER_OP(LCD_RASTER_OP_INVERT);
+	uc_graphics_fill_rect(x, y, width, height, 1);
+	LCD_API_SET_RASTER_OP(previous_op);
+}
+#endif
+
+/**
+ * Fills a horizontal span of pixels. Uses the byte wise LCD_API_FILL_RECT
+ * if the LCD offers it, otherwise every pixel is set on its own.
+ *
+ * params:
+ * 		- x1: x coordinate of first pixel
+ * 		- x2: x coordinate of last pixel (x2 >= x1)
+ * 		- y: y coordinate of span
+ * 		- pixel: pixel value (0 or 1)
+ */
+void uc_graphics_fill_span(uint8_t x1, uint8_t x2, uint8_t y, uint8_t pixel) {
+	#ifdef LCD_API_FILL_RECT
+		LCD_API_FILL_RECT(x1, y, x2-x1+1, 1, pixel);
+	#else
+		for ( uint16_t x = x1; x <= x2; x++ ) {
+			LCD_API_SET_PIXEL(x, y, pixel);
+		}
+	#endif
+}
+
+
+/*
+ * Pattern fills.
+ *
+ * A pattern is an 8x8 stipple of 8 bytes stored in PROGMEM. Byte n holds
+ * the pixels of all columns with x%8 == n, bit m the pixel of rows with
+ * y%8 == m (LSB is the top row). This is the byte layout of the display
+ * buffer, so a pattern fill costs the same as a solid fill. Patterns are
+ * anchored to the display, adjacent fills continue seamlessly.
+ *
+ * Pattern bits of value 0 are drawn as white pixels (raster operation COPY)
+ * or leave the buffer untouched (OR/XOR).
+ */
+
+const uint8_t UC_GRAPHICS_PATTERN_GRAY_50[8] PROGMEM = {0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA};
+const uint8_t UC_GRAPHICS_PATTERN_GRAY_25[8] PROGMEM = {0x11, 0x00, 0x44, 0x00, 0x11, 0x00, 0x44, 0x00};
+const uint8_t UC_GRAPHICS_PATTERN_GRAY_75[8] PROGMEM = {0xEE, 0xFF, 0xBB, 0xFF, 0xEE, 0xFF, 0xBB, 0xFF};
+const uint8_t UC_GRAPHICS_PATTERN_HATCH_DIAGONAL[8] PROGMEM = {0x11, 0x22, 0x44, 0x88, 0x11, 0x22, 0x44, 0x88};
+const uint8_t UC_GRAPHICS_PATTERN_HATCH_HORIZONTAL[8] PROGMEM = {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11};
+const uint8_t UC_GRAPHICS_PATTERN_HATCH_VERTICAL[8] PROGMEM = {0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00};
+
+/**
+ * Copies a pattern from PROGMEM into RAM, so that the fill loops do not
+ * need to read from flash.
+ *
+ * params:
+ * 		- progmem_pattern: 8 pattern bytes stored in progmem
+ * 		- pattern: destination of 8 bytes in RAM
+ */
+void uc_graphics_load_pattern(const uint8_t *progmem_pattern, uint8_t *pattern) {
+	for ( uint8_t i = 0; i < 8; i++ ) {
+		pattern[i] = pgm_read_byte(&progmem_pattern[i]);
+	}
+}
+
+/**
+ * Fills a horizontal span of pixels with a pattern.
+ *
+ * params:
+ * 		- x1: x coordinate of first pixel
+ * 		- x2: x coordinate of last pixel (x2 >= x1)
+ * 		- y: y coordinate of span
+ * 		- pattern: 8 pattern bytes in RAM (see uc_graphics_load_pattern)
+ */
+void uc_graphics_fill_span_pattern(uint8_t x1, uint8_t x2, uint8_t y, const uint8_t *pattern) {
+	#ifdef LCD_API_FILL_RECT_PATTERN
+		LCD_API_FILL_RECT_PATTERN(x1, y, x2-x1+1, 1, pattern);
+	#else
+		uint8_t bit = y%8;
+		for ( uint16_t x = x1; x <= x2; x++ ) {
+			LCD_API_SET_PIXEL(x, y, (pattern[x%8] >> bit) & 0x01);
+		}
+	#endif
+}
+
+/**
+ * Fills a rectangle with a pattern.
+ *
+ * params:
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of rectangle
+ * 		- height: height of rectangle
+ * 		- progmem_pattern: 8 pattern bytes stored in progmem
+ */
+void uc_graphics_fill_rect_pattern(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *progmem_pattern) {
+	if ( width == 0 || height == 0 ) return;
+
+	uint8_t pattern[8];
+	uc_graphics_load_pattern(progmem_pattern, pattern);
+
+	#ifdef LCD_API_FILL_RECT_PATTERN
+		LCD_API_FILL_RECT_PATTERN(x, y, width, height, pattern);
+	#else
+		for ( uint8_t j = 0; j < height; j++ ) {
+			uc_graphics_fill_span_pattern(x, x+width-1, y+j, pattern);
+		}
+	#endif
+}
+
+/*
+ * Fills a span either solid or with a pattern (if pattern is not 0).
+ */
+void uc_graphics_fill_span_internal(uint8_t x1, uint8_t x2, uint8_t y, uint8_t pixel, const uint8_t *pattern) {
+	if ( pattern ) uc_graphics_fill_span_pattern(x1, x2, y, pattern);
+	else uc_graphics_fill_span(x1, x2, y, pixel);
+}
+
+
+/*
+ * Circle filling.
+ *
+ * For every row the half width is the largest dx with dx*dx + dy*dy <= r*r + r,
+ * which matches the look of the midpoint circle algorithm. The half width
+ * only shrinks from the middle row outwards, so it is found incrementally.
+ * Every row is one span, no pixel is touched twice.
+ */
+void uc_graphics_fill_circle_internal(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t pixel, const uint8_t *pattern) {
+	int32_t limit = (int32_t)radius*radius + radius;
+	int16_t dx = radius;
+
+	for ( int16_t dy = 0; dy <= radius; dy++ ) {
+		while ( (int32_t)dx*dx + (int32_t)dy*dy > limit ) dx--;
+
+		int16_t x1 = (int16_t)center_x - dx;
+		int16_t x2 = (int16_t)center_x + dx;
+		if ( x1 < 0 ) x1 = 0;
+		if ( x2 > 254 ) x2 = 254; //span width must fit into uint8_t
+
+		int16_t y_below = (int16_t)center_y + dy;
+		int16_t y_above = (int16_t)center_y - dy;
+
+		if ( y_below < 256 ) uc_graphics_fill_span_internal(x1, x2, y_below, pixel, pattern);
+		if ( dy > 0 && y_above >= 0 ) uc_graphics_fill_span_internal(x1, x2, y_above, pixel, pattern);
+	}
+}
+
+/**
+ * Fills a circle.
+ *
+ * params:
+ * 		- center_x: x coordinate of center
+ * 		- center_y: y coordinate of center
+ * 		- radius: radius in pixels (0 fills only the center pixel)
+ * 		- pixel: pixel value (0 or 1)
+ */
+void uc_graphics_fill_circle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t pixel) {
+	uc_graphics_fill_circle_internal(center_x, center_y, radius, pixel, 0);
+}
+
+/**
+ * Fills a circle with a pattern.
+ *
+ * params:
+ * 		- center_x: x coordinate of center
+ * 		- center_y: y coordinate of center
+ * 		- radius: radius in pixels (0 fills only the center pixel)
+ * 		- progmem_pattern: 8 pattern bytes stored in progmem
+ */
+void uc_graphics_fill_circle_pattern(uint8_t center_x, uint8_t center_y, uint8_t radius, const uint8_t *progmem_pattern) {
+	uint8_t pattern[8];
+	uc_graphics_load_pattern(progmem_pattern, pattern);
+
+	uc_graphics_fill_circle_internal(center_x, center_y, radius, 1, pattern);
+}
+
+
+struct uc_graphics_rect_struct {
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;
+	uint8_t height;
+};
+
+typedef struct uc_graphics_rect_struct uc_graphics_rect;
+
+/**
+ * Checks if two rectangles share at least one pixel.
+ *
+ * params:
+ * 		- a: first rectangle
+ * 		- b: second rectangle
+ *
+ * returns: 1 if rectangles overlap, 0 if not.
+ */
+uint8_t uc_graphics_rects_overlap(const uc_graphics_rect *a, const uc_graphics_rect *b) {
+	if ( a->width == 0 || a->height == 0 || b->width == 0 || b->height == 0 ) return 0;
+	if ( (uint16_t)a->x + a->width <= b->x || (uint16_t)b->x + b->width <= a->x ) return 0;
+	if ( (uint16_t)a->y + a->height <= b->y || (uint16_t)b->y + b->height <= a->y ) return 0;
+	return 1;
+}
+
+/**
+ * Extends a rectangle, so that it also covers another one.
+ *
+ * params:
+ * 		- target: rectangle to extend (empty rectangles take over addition)
+ * 		- addition: rectangle to cover
+ */
+void uc_graphics_rect_union(uc_graphics_rect *target, const uc_graphics_rect *addition) {
+	if ( addition->width == 0 || addition->height == 0 ) return;
+	if ( target->width == 0 || target->height == 0 ) {
+		*target = *addition;
+		return;
+	}
+
+	uint16_t right = (uint16_t)target->x + target->width;
+	uint16_t bottom = (uint16_t)target->y + target->height;
+	if ( (uint16_t)addition->x + addition->width > right ) right = (uint16_t)addition->x + addition->width;
+	if ( (uint16_t)addition->y + addition->height > bottom ) bottom = (uint16_t)addition->y + addition->height;
+	if ( addition->x < target->x ) target->x = addition->x;
+	if ( addition->y < target->y ) target->y = addition->y;
+
+	target->width = right - target->x;
+	target->height = bottom - target->y;
+}
+
+/**
+ * Copies a rectangle of the display to another position. Source and
+ * destination may overlap. Uses LCD_API_COPY_RECT if the LCD offers it,
+ * otherwise the pixels are copied one by one using LCD_API_GET_PIXEL.
+ * Both ways the pixels are copied as they are (no raster operation),
+ * pixels whose source or destination is outside the display are skipped
+ * and destination pixels outside the clip rectangle (LCD_API_SET_CLIP)
+ * are not written.
+ *
+ * params:
+ * 		- src_x: x coordinate of left column of source
+ * 		- src_y: y coordinate of top row of source
+ * 		- width: width of rectangle
+ * 		- height: height of rectangle
+ * 		- dst_x: x coordinate of left column of destination
+ * 		- dst_y: y coordinate of top row of destination
+ */
+void uc_graphics_copy_rect(uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t dst_x, uint8_t dst_y) {
+	#ifdef LCD_API_COPY_RECT
+		LCD_API_COPY_RECT(src_x, src_y, width, height, dst_x, dst_y);
+	#else
+		#ifdef LCD_API_GET_TARGET_WIDTH
+			uint16_t right_x = LCD_API_GET_TARGET_WIDTH();
+			uint16_t bottom_y = LCD_API_GET_TARGET_HEIGHT();
+		#else
+			uint16_t right_x = LCD_API_WIDTH;
+			uint16_t bottom_y = LCD_API_HEIGHT;
+		#endif
+
+		//Skip source and destination pixels outside the display, else
+		//dst_x + column wraps around to the left edge
+		if ( src_x >= right_x || src_y >= bottom_y ) return;
+		if ( dst_x >= right_x || dst_y >= bottom_y ) return;
+		if ( width > right_x - src_x ) width = right_x - src_x;
+		if ( width > right_x - dst_x ) width = right_x - dst_x;
+		if ( height > bottom_y - src_y ) height = bottom_y - src_y;
+		if ( height > bottom_y - dst_y ) height = bottom_y - dst_y;
+
+		#ifdef LCD_API_SET_RASTER_OP
+			uint8_t previous_op = LCD_API_GET_RASTER_OP();
+			LCD_API_SET_RASTER_OP(LCD_RASTER_OP_COPY);
+		#endif
+
+		//Walk against the direction of movement to not overwrite source pixels
+		for ( uint8_t j = 0; j < height; j++ ) {
+			uint8_t row = (dst_y > src_y) ? (height - 1 - j) : j;
+			for ( uint8_t i = 0; i < width; i++ ) {
+				uint8_t column = (dst_x > src_x) ? (width - 1 - i) : i;
+				LCD_API_SET_PIXEL(dst_x + column, dst_y + row, LCD_API_GET_PIXEL(src_x + column, src_y + row));
+			}
+		}
+
+		#ifdef LCD_API_SET_RASTER_OP
+			LCD_API_SET_RASTER_OP(previous_op);
+		#endif
+	#endif
+}
+
+/**
+ * Scrolls the content of a rectangle, e.g. a strip chart or a list. Content
+ * moved outside the rectangle is dropped, the uncovered area is filled.
+ * Only the rectangle is redrawn (and marked dirty).
+ *
+ * params:
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of rectangle
+ * 		- height: height of rectangle
+ * 		- dx: horizontal movement (negative: to the left)
+ * 		- dy: vertical movement (negative: upwards)
+ * 		- fill_pixel: pixel value for the uncovered area (0 or 1)
+ */
+void uc_graphics_scroll_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int8_t dx, int8_t dy, uint8_t fill_pixel) {
+	uint8_t abs_dx = dx < 0 ? -dx : dx;
+	uint8_t abs_dy = dy < 0 ? -dy : dy;
+
+	if ( abs_dx >= width || abs_dy >= height ) {
+		uc_graphics_fill_rect(x, y, width, height, fill_pixel);
+		return;
+	}
+
+	uint8_t src_x = dx < 0 ? x + abs_dx : x;
+	uint8_t src_y = dy < 0 ? y + abs_dy : y;
+	uint8_t dst_x = dx < 0 ? x : x + abs_dx;
+	uint8_t dst_y = dy < 0 ? y : y + abs_dy;
+
+	uc_graphics_copy_rect(src_x, src_y, width - abs_dx, height - abs_dy, dst_x, dst_y);
+
+	//Uncovered columns and rows
+	if ( abs_dx ) uc_graphics_fill_rect(dx < 0 ? x + width - abs_dx : x, y, abs_dx, height, fill_pixel);
+	if ( abs_dy ) uc_graphics_fill_rect(dx < 0 ? x : x + abs_dx, dy < 0 ? y + height - abs_dy : y, width - abs_dx, abs_dy, fill_pixel);
+}
+
+
+/*
+ * Scanline polygon filling.
+ *
+ * Vertices are pixel centers and scanlines are sampled at pixel centers.
+ * Like the classic top-left rule, pixels exactly on the bottom or right
+ * edges are not filled, so polygons sharing an edge never overlap.
+ *
+ * The edge table lives in an arena handed in by the caller (one edge per
+ * vertex is enough), nothing is allocated. X coordinates of edges are kept
+ * in 16.16 fixed point and are advanced incrementally per scanline.
+ */
+
+struct uc_graphics_point_struct {
+	uint8_t x;
+	uint8_t y;
+};
+
+typedef struct uc_graphics_point_struct uc_graphics_point;
+
+struct uc_graphics_edge_struct {
+	int32_t x;			//16.16 fixed point x coordinate at current scanline
+	int32_t dx;			//16.16 fixed point x increment per scanline
+	uint8_t y_top;		//first scanline of edge
+	uint8_t y_bottom;	//first scanline after edge
+};
+
+typedef struct uc_graphics_edge_struct uc_graphics_edge;
+
+#define UC_GRAPHICS_EDGE_INACTIVE INT32_MAX
+
+/*
+ * Fills a polygon either solid or with a pattern (if pattern is not 0).
+ * See uc_graphics_fill_polygon for details.
+ */
+uint8_t uc_graphics_fill_polygon_internal(const uc_graphics_point *points,
+										  uint8_t count,
+										  uc_graphics_edge *edge_arena,
+										  uint8_t arena_size,
+										  uint8_t pixel,
+										  const uint8_t *pattern) {
+
+	uint8_t edge_count = 0;
+	uint8_t min_y = 255;
+	uint8_t max_y = 0;
+
+	//Build edge table, horizontal edges do not cross any scanline
+	for ( uint8_t i = 0; i < count; i++ ) {
+		const uc_graphics_point *a = &points[i];
+		const uc_graphics_point *b = &points[(i+1 == count) ? 0 : i+1];
+
+		if ( a->y == b->y ) continue;
+		if ( a->y > b->y ) {
+			const uc_graphics_point *swap = a;
+			a = b;
+			b = swap;
+		}
+
+		if ( edge_count == arena_size ) return 0;
+
+		uc_graphics_edge *edge = &edge_arena[edge_count++];
+		edge->x = (int32_t)a->x * 65536L;
+		edge->dx = ((int32_t)b->x - (int32_t)a->x) * 65536L / (int32_t)(b->y - a->y);
+		edge->y_top = a->y;
+		edge->y_bottom = b->y;
+
+		if ( a->y < min_y ) min_y = a->y;
+		if ( b->y > max_y ) max_y = b->y;
+	}
+
+	if ( edge_count < 2 ) return 1;
+
+	for ( uint8_t y = min_y; y < max_y; y++ ) {
+
+		//Sort edges by crossing at this scanline, inactive ones go to the end.
+		//The order hardly changes between scanlines, so insertion sort is cheap.
+		for ( uint8_t i = 1; i < edge_count; i++ ) {
+			uc_graphics_edge current = edge_arena[i];
+			int32_t current_key = (y >= current.y_top && y < current.y_bottom) ? current.x : UC_GRAPHICS_EDGE_INACTIVE;
+
+			uint8_t j = i;
+			while ( j > 0 ) {
+				uc_graphics_edge *previous = &edge_arena[j-1];
+				int32_t previous_key = (y >= previous->y_top && y < previous->y_bottom) ? previous->x : UC_GRAPHICS_EDGE_INACTIVE;
+				if ( previous_key <= current_key ) break;
+
+				edge_arena[j] = *previous;
+				j--;
+			}
+			edge_arena[j] = current;
+		}
+
+		//Fill between pairs of crossings (even-odd)
+		for ( uint8_t i = 0; i+1 < edge_count; i += 2 ) {
+			uc_graphics_edge *left = &edge_arena[i];
+			uc_graphics_edge *right = &edge_arena[i+1];
+			if ( !(y >= right->y_top && y < right->y_bottom) ) break;
+
+			int32_t x_start = (left->x + 0xFFFF) >> 16;
+			int32_t x_end = ((right->x + 0xFFFF) >> 16) - 1;
+			if ( x_start < 0 ) x_start = 0;
+			if ( x_end > 254 ) x_end = 254; //span width must fit into uint8_t
+
+			if ( x_start <= x_end ) uc_graphics_fill_span_internal(x_start, x_end, y, pixel, pattern);
+		}
+
+		//Step active edges to next scanline
+		for ( uint8_t i = 0; i < edge_count; i++ ) {
+			uc_graphics_edge *edge = &edge_arena[i];
+			if ( y >= edge->y_top && y < edge->y_bottom ) edge->x += edge->dx;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * Fills a polygon using the even-odd rule. Works for convex, concave
+ * and self intersecting polygons.
+ *
+ * params:
+ * 		- points: vertices of polygon, last one is connected to first one
+ * 		- count: amount of vertices
+ * 		- edge_arena: memory for edge table, must hold count edges
+ * 		- arena_size: amount of edges edge_arena can hold
+ * 		- pixel: pixel value (0 or 1)
+ *
+ * returns: 1 if polygon has been filled, 0 if edge_arena was too small.
+ */
+uint8_t uc_graphics_fill_polygon(const uc_graphics_point *points,
+								 uint8_t count,
+								 uc_graphics_edge *edge_arena,
+								 uint8_t arena_size,
+								 uint8_t pixel) {
+
+	return uc_graphics_fill_polygon_internal(points, count, edge_arena, arena_size, pixel, 0);
+}
+
+/**
+ * Fills a polygon with a pattern using the even-odd rule.
+ *
+ * params:
+ * 		- points: vertices of polygon, last one is connected to first one
+ * 		- count: amount of vertices
+ * 		- edge_arena: memory for edge table, must hold count edges
+ * 		- arena_size: amount of edges edge_arena can hold
+ * 		- progmem_pattern: 8 pattern bytes stored in progmem
+ *
+ * returns: 1 if polygon has been filled, 0 if edge_arena was too small.
+ */
+uint8_t uc_graphics_fill_polygon_pattern(const uc_graphics_point *points,
+										 uint8_t count,
+										 uc_graphics_edge *edge_arena,
+										 uint8_t arena_size,
+										 const uint8_t *progmem_pattern) {
+
+	uint8_t pattern[8];
+	uc_graphics_load_pattern(progmem_pattern, pattern);
+
+	return uc_graphics_fill_polygon_internal(points, count, edge_arena, arena_size, 1, pattern);
+}
+
+/**
+ * Fills a triangle. Uses the same rules as uc_graphics_fill_polygon, the
+ * edge table is kept on the stack.
+ *
+ * params:
+ * 		- x1, y1: first vertex
+ * 		- x2, y2: second vertex
+ * 		- x3, y3: third vertex
+ * 		- pixel: pixel value (0 or 1)
+ */
+void uc_graphics_fill_triangle(uint8_t x1, uint8_t y1,
+							   uint8_t x2, uint8_t y2,
+							   uint8_t x3, uint8_t y3,
+							   uint8_t pixel) {
+
+	uc_graphics_point points[3] = { {x1, y1}, {x2, y2}, {x3, y3} };
+	uc_graphics_edge edges[3];
+
+	uc_graphics_fill_polygon(points, 3, edges, 3, pixel);
+}
+
+#ifdef LCD_API_GET_PIXEL
+/*
+ * Flood fill.
+ *
+ * Scanline seed fill (Heckbert): a seed is a span of a row which has to be
+ * searched for pixels of the region, together with the direction it was
+ * found from. Every found run is extended to its full length, filled at
+ * once through uc_graphics_fill_span and its neighbour rows are pushed as
+ * new seeds. The seed stack is provided by the caller, so memory usage is
+ * fixed (4 bytes per seed, 24 seeds are enough for most icons and shapes
+ * on a 128x64 display, noisy regions need more).
+ */
+
+struct uc_graphics_fill_seed_struct {
+	uint8_t x1;
+	uint8_t x2;
+	uint8_t y;
+	int8_t dy;					//direction of row which found this seed
+};
+
+typedef struct uc_graphics_fill_seed_struct uc_graphics_fill_seed;
+
+/**
+ * Fills the region of connected (4-neighbourhood) pixels which have the
+ * inverse of the given pixel value and contain the start pixel.
+ *
+ * If the seed stack is full, further seeds are dropped instead of
+ * overflowing: the fill stays inside the region but may leave parts of it
+ * unfilled. Calling the function again with a start pixel in the unfilled
+ * part or with a bigger stack completes it.
+ *
+ * The raster operation is temporarily set to COPY, as the fill reads back
+ * the pixels it wrote. For the same reason the region ends at the edges
+ * of the clip rectangle (LCD_API_GET_CLIP).
+ *
+ * params:
+ * 		- x: x coordinate of start pixel
+ * 		- y: y coordinate of start pixel
+ * 		- pixel: pixel value (0 or 1) to fill with
+ * 		- seed_stack: memory for seeds
+ * 		- stack_size: amount of seeds seed_stack can hold (at least 2)
+ *
+ * returns: 1 if region has been filled completely, 0 if seeds were dropped.
+ */
+uint8_t uc_graphics_flood_fill(uint8_t x, uint8_t y, uint8_t pixel,
+							   uc_graphics_fill_seed *seed_stack, uint8_t stack_size) {
+
+	#ifdef LCD_API_GET_TARGET_WIDTH
+		uint8_t width = LCD_API_GET_TARGET_WIDTH();
+		uint8_t height = LCD_API_GET_TARGET_HEIGHT();
+	#else
+		uint8_t width = LCD_API_WIDTH;
+		uint8_t height = LCD_API_HEIGHT;
+	#endif
+
+	uint8_t left = 0;
+	uint8_t top = 0;
+	uint8_t right = width - 1;
+	uint8_t bottom = height - 1;
+
+	#ifdef LCD_API_GET_CLIP
+		LCD_API_CLIP clip;
+		LCD_API_GET_CLIP(&clip);
+
+		if ( clip.left > left ) left = clip.left;
+		if ( clip.top > top ) top = clip.top;
+		if ( clip.right < right ) right = clip.right;
+		if ( clip.bottom < bottom ) bottom = clip.bottom;
+	#endif
+
+	uint8_t old_pixel = !pixel;
+	if ( x < left || x > right || y < top || y > bottom ) return 1;
+	if ( LCD_API_GET_PIXEL(x, y) != old_pixel ) return 1;
+
+	#ifdef LCD_API_SET_RASTER_OP
+		uint8_t previous_op = LCD_API_GET_RASTER_OP();
+		LCD_API_SET_RASTER_OP(LCD_RASTER_OP_COPY);
+	#endif
+
+	uint8_t count = 0;
+	uint8_t complete = 1;
+
+	//Row of start pixel and row above it, both searched at x only
+	seed_stack[count++] = (uc_graphics_fill_seed){ x, x, y, 1 };
+	if ( y > top && stack_size > 1 ) seed_stack[count++] = (uc_graphics_fill_seed){ x, x, (uint8_t)(y-1), -1 };
+
+	while ( count > 0 ) {
+		uc_graphics_fill_seed seed = seed_stack[--count];
+		uint8_t current_x = seed.x1;
+
+		while ( current_x <= seed.x2 ) {
+			if ( LCD_API_GET_PIXEL(current_x, seed.y) != old_pixel ) {
+				current_x++;
+				continue;
+			}
+
+			//Extend run: to the left only possible at the start of the seed
+			uint8_t start = current_x;
+			if ( current_x == seed.x1 ) {
+				while ( start > left && LCD_API_GET_PIXEL(start-1, seed.y) == old_pixel ) start--;
+			}
+			uint8_t end = current_x;
+			while ( end < right && LCD_API_GET_PIXEL(end+1, seed.y) == old_pixel ) end++;
+
+			uc_graphics_fill_span(start, end, seed.y, pixel);
+
+			//Continue in same direction, parts beyond the seed also backwards
+			for ( uint8_t i = 0; i < 3; i++ ) {
+				int8_t dy = (i == 0) ? seed.dy : -seed.dy;
+				uint8_t x1 = start;
+				uint8_t x2 = end;
+
+				if ( i == 1 ) {
+					if ( start >= seed.x1 ) continue;
+					x2 = seed.x1 - 1;
+				} else if ( i == 2 ) {
+					if ( end <= seed.x2 ) continue;
+					x1 = seed.x2 + 1;
+				}
+
+				int16_t row = (int16_t)seed.y + dy;
+				if ( row < top || row > bottom ) continue;
+
+				if ( count < stack_size ) seed_stack[count++] = (uc_graphics_fill_seed){ x1, x2, (uint8_t)row, dy };
+				else complete = 0;
+			}
+
+			if ( end >= seed.x2 ) break;
+			current_x = end + 2; //pixel after run is not part of region
+		}
+	}
+
+	#ifdef LCD_API_SET_RASTER_OP
+		LCD_API_SET_RASTER_OP(previous_op);
+	#endif
+
+	return complete;
 }
+#endif
 
 #endif /* SRC_GRAPHICS_H_ */
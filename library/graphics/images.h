@@ -5,6 +5,7 @@
  * It tells which pixel direction is used:
  * 	- bit 5 == 1: left to right, top to bottom (hv)
  * 	- bit 4 == 1: top to bottom, left to right (vh)
+ * 	- bit 3 == 1: page major (pm), see below
  *
  * 	The second and third byte store the width and
  * 	height of an image.
@@ -12,6 +13,11 @@
  * 	Byte 3 & up store the pixels stored LSB and zero padded
  * 	at the end.
  *
+ * 	Page major images store (height+7)/8 rows of width bytes instead,
+ * 	every byte holds 8 vertical pixels of a column (LSB is the top
+ * 	pixel). This is the layout of KS0108 style display buffers: with
+ * 	LCD_API_FAST_BLIT they are copied byte wise from flash.
+ *
  *
  *
  * 	Images can be encoded using µC-Graphics-Tools:
@@ -19,6 +25,17 @@
  * 	https://github.com/hedgehogs-mind/uc-graphics-tools
  *
  *
+ * 	Images are drawn through LCD_API_SET_PIXEL, so the raster operation
+ * 	of the LCD is honoured (e.g. XOR an icon on and off again).
+ *
+ *
+ * 	Grayscale data (thumbnails, heatmaps, ...) generated at runtime can be
+ * 	drawn with uc_images_draw_gray. It is streamed row by row from a
+ * 	callback and dithered to black and white, either by Floyd-Steinberg
+ * 	error diffusion or by an ordered 8x8 Bayer matrix. Memory usage only
+ * 	depends on the width, the image itself is never kept in RAM.
+ *
+ *
  *
  *
  * This is free software:
@@ -52,10 +69,12 @@
 #error "µC-Graphics image library does require LCD_API_SET_PIXEL makro to be set, in order to draw an image."
 #endif
 
+#include <string.h>
 #include <avr/pgmspace.h>
 
 #define UC_IMG_SETTINGS_BIT_HV_MASK (1 << 5)
 #define UC_IMG_SETTINGS_BIT_VH_MASK (1 << 4)
+#define UC_IMG_SETTINGS_BIT_PM_MASK (1 << 3)
 
 /**
  * Retrieves the settings byte of an image stored in PROGMEM.
@@ -109,6 +128,23 @@ void uc_images_draw(uint8_t x, uint8_t y, uint8_t draw_white_pixels, const uint8
 	uint8_t height = pgm_read_byte(&progmem_img[2]);
 	uint16_t wh = width*height;
 
+	if ( settings & UC_IMG_SETTINGS_BIT_PM_MASK ) {
+		#ifdef LCD_API_FAST_BLIT
+			LCD_API_BLIT(x, y, width, height, &progmem_img[3], draw_white_pixels ? 0 : &progmem_img[3], 1);
+		#else
+			for ( uint8_t row = 0; row < height; row++ ) {
+				uint16_t page_index = 3 + (row/8) * width;
+
+				for ( uint8_t column = 0; column < width; column++ ) {
+					uint8_t pixel = (pgm_read_byte(&progmem_img[page_index + column]) >> (row%8)) & 0x01;
+					if ( pixel ) LCD_API_SET_PIXEL(x + column, y + row, 1);
+					else if ( draw_white_pixels ) LCD_API_SET_PIXEL(x + column, y + row, 0);
+				}
+			}
+		#endif
+		return;
+	}
+
 	uint16_t byte_index = 3;
 	uint8_t current_x = x;
 	uint8_t current_y = y;
@@ -150,4 +186,128 @@ void uc_images_draw(uint8_t x, uint8_t y, uint8_t draw_white_pixels, const uint8
 	}
 }
 
+#define UC_IMAGES_DITHER_FLOYD_STEINBERG	0
+#define UC_IMAGES_DITHER_BAYER				1
+
+/* Thresholds of ordered dithering, gray values below are drawn black */
+const uint8_t UC_IMAGES_BAYER_8X8[64] PROGMEM = {
+	2, 130, 34, 162, 10, 138, 42, 170,
+	194, 66, 226, 98, 202, 74, 234, 106,
+	50, 178, 18, 146, 58, 186, 26, 154,
+	242, 114, 210, 82, 250, 122, 218, 90,
+	14, 142, 46, 174, 6, 134, 38, 166,
+	206, 78, 238, 110, 198, 70, 230, 102,
+	62, 190, 30, 158, 54, 182, 22, 150,
+	254, 126, 222, 94, 246, 118, 214, 86
+};
+
+/*
+ * Draws up to 8 rows collected in page layout (LSB is the top row).
+ */
+void uc_images_draw_page_bytes(uint8_t x, uint8_t y, uint8_t width, uint8_t rows, const uint8_t *page_bytes) {
+	#ifdef LCD_API_FAST_BLIT
+		LCD_API_BLIT(x, y, width, rows, page_bytes, 0, 0);
+	#else
+		for ( uint8_t row = 0; row < rows; row++ ) {
+			for ( uint8_t i = 0; i < width; i++ ) {
+				LCD_API_SET_PIXEL(x + i, y + row, (page_bytes[i] >> row) & 0x01);
+			}
+		}
+	#endif
+}
+
+/**
+ * Draws grayscale data streamed row by row, dithered to black and white.
+ * Every 8 rows are collected in page layout and drawn at once (through
+ * LCD_API_BLIT if LCD_API_FAST_BLIT is set, so at page aligned y
+ * coordinates whole bytes are written). Black and white pixels are drawn.
+ *
+ * Floyd-Steinberg diffuses the error of every pixel to its neighbours and
+ * keeps the errors of one row (2 bytes per column). Bayer compares every
+ * pixel with a threshold matrix stored in progmem and needs no error row,
+ * its regular pattern also stays stable when the data changes slightly.
+ *
+ * params:
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of data
+ * 		- height: height of data
+ * 		- mode: UC_IMAGES_DITHER_FLOYD_STEINBERG or UC_IMAGES_DITHER_BAYER
+ * 		- read_row: callback writing width gray values (0 = black, 255 = white) of a row
+ * 		- context: passed to read_row
+ * 		- gray_row: memory for width gray values
+ * 		- page_bytes: memory for width bytes
+ * 		- error_row: memory for width errors (Floyd-Steinberg only, may be 0 for Bayer)
+ */
+void uc_images_draw_gray(uint8_t x,
+						 uint8_t y,
+						 uint8_t width,
+						 uint8_t height,
+						 uint8_t mode,
+						 void (*read_row)(uint8_t row, uint8_t *gray, void *context),
+						 void *context,
+						 uint8_t *gray_row,
+						 uint8_t *page_bytes,
+						 int16_t *error_row) {
+
+	if ( width == 0 ) return;
+
+	if ( mode == UC_IMAGES_DITHER_FLOYD_STEINBERG ) {
+		for ( uint8_t i = 0; i < width; i++ ) error_row[i] = 0;
+	}
+
+	memset(page_bytes, 0, width);
+	uint8_t band_y = y;
+	uint8_t band_row = 0;
+
+	for ( uint8_t row = 0; row < height; row++ ) {
+		read_row(row, gray_row, context);
+		uint8_t bit = (1 << band_row);
+
+		if ( mode == UC_IMAGES_DITHER_BAYER ) {
+			const uint8_t *thresholds = &UC_IMAGES_BAYER_8X8[((y + row) % 8) * 8];
+
+			for ( uint8_t i = 0; i < width; i++ ) {
+				if ( gray_row[i] < pgm_read_byte(&thresholds[(x + i) % 8]) ) page_bytes[i] |= bit;
+			}
+		} else {
+			//error_row holds the errors for this row at columns not yet
+			//processed and the errors for the next row at processed ones
+			int16_t right = 0;			//7/16 for next column
+			int16_t below_right = 0;	//1/16 for next column of next row
+			int16_t below_previous = 0;	//collected for previous column of next row
+
+			for ( uint8_t i = 0; i < width; i++ ) {
+				int16_t value = gray_row[i] + error_row[i] + right;
+				int16_t error = value;
+
+				if ( value < 128 ) {
+					page_bytes[i] |= bit;
+				} else {
+					error = value - 255;
+				}
+
+				int16_t error_3 = (error * 3) / 16;
+				int16_t error_5 = (error * 5) / 16;
+				int16_t error_1 = error / 16;
+				right = error - error_3 - error_5 - error_1;
+
+				if ( i > 0 ) error_row[i-1] = below_previous + error_3;
+				below_previous = below_right + error_5;
+				below_right = error_1;
+			}
+
+			error_row[width-1] = below_previous;
+		}
+
+		band_row++;
+		if ( band_row == 8 || row == height - 1 ) {
+			uc_images_draw_page_bytes(x, band_y, width, band_row, page_bytes);
+			memset(page_bytes, 0, width);
+			band_y += 8;
+			band_row = 0;
+		}
+	}
+}
+
 #endif
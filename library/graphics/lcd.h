@@ -86,6 +86,16 @@
  * 			  to Qa, Qb or Qc by defining the numerical pin number
  * 			  (Qa: 0, Qb: 1, Qc: 2).
  *
+ * Off-screen canvases:
+ * 		- A canvas is a caller provided 1-bpp buffer of any size
+ * 		  in page layout (uc_lcd_canvas_init).
+ * 		- uc_lcd_set_target redirects all drawing operations into
+ * 		  a canvas, so static backgrounds or panels can be rendered
+ * 		  once with the usual graphics, font and image functions.
+ * 		- uc_lcd_blit_canvas composites a canvas (optionally masked,
+ * 		  with the current raster operation) into the display buffer
+ * 		  or another canvas.
+ *
  *
  *
  *
@@ -119,6 +129,8 @@
 
 #include <util/delay.h>
 #include <stdint.h>
+#include <string.h>
+#include <avr/pgmspace.h>
 
 
 
@@ -469,6 +481,69 @@ These two macros for defining the enable latch times:
 uint8_t uc_lcd_buffer[1024];
 uint8_t uc_lcd_inverted = 0;
 
+/*
+ * Raster operation applied on every pixel/byte write:
+ * 		- COPY: pixel value overwrites buffer (default).
+ * 		- OR: pixel value 1 sets the pixel, 0 leaves it untouched.
+ * 		- AND_NOT: pixel value 1 clears the pixel, 0 leaves it untouched.
+ * 		- XOR: pixel value 1 toggles the pixel, 0 leaves it untouched.
+ * 		- INVERT: every touched pixel is toggled, pixel value is ignored.
+ */
+#define LCD_RASTER_OP_COPY		0
+#define LCD_RASTER_OP_OR		1
+#define LCD_RASTER_OP_AND_NOT	2
+#define LCD_RASTER_OP_XOR		3
+#define LCD_RASTER_OP_INVERT	4
+
+uint8_t uc_lcd_raster_op = LCD_RASTER_OP_COPY;
+
+/*
+ * Memory layout of a canvas which does not store its pixels in page rows,
+ * e.g. uc_canvas of canvas_template.h. get_index retrieves the buffer
+ * index of the byte holding the 8 pixels of a column within a page,
+ * run_width is the amount of columns stored one after another (64 for
+ * KS0108 chips, 0 if whole rows are).
+ */
+struct uc_lcd_canvas_layout_struct {
+	uint16_t (*get_index)(uint8_t x, uint8_t page);
+	uint8_t run_width;
+};
+
+typedef struct uc_lcd_canvas_layout_struct uc_lcd_canvas_layout;
+
+/*
+ * Off-screen canvas. Pixels are stored in page layout: (height+7)/8 rows
+ * of width bytes, every byte holds 8 vertical pixels of a column (LSB is
+ * the top pixel), unless layout is set. Pixels are never stored inverted.
+ */
+struct uc_lcd_canvas_struct {
+	uint8_t *buffer;
+	uint8_t width;
+	uint8_t height;
+	const uc_lcd_canvas_layout *layout;		//0: page layout
+};
+
+typedef struct uc_lcd_canvas_struct uc_lcd_canvas;
+
+/* Render target: 0 draws into uc_lcd_buffer, otherwise into a canvas */
+uc_lcd_canvas *uc_lcd_target = 0;
+
+/* Clip rectangle (inclusive) of drawing operations, default is everything */
+uint8_t uc_lcd_clip_left = 0;
+uint8_t uc_lcd_clip_top = 0;
+uint8_t uc_lcd_clip_right = 255;
+uint8_t uc_lcd_clip_bottom = 255;
+
+/* Saved clip rectangle, see uc_lcd_get_clip() */
+struct uc_lcd_clip_struct {
+	uint8_t left;
+	uint8_t top;
+	uint8_t right;
+	uint8_t bottom;
+};
+
+typedef struct uc_lcd_clip_struct uc_lcd_clip;
+
 
 /* Introduce variables for immediate drawing mode */
 #ifdef LCD_MODE_IMMEDIATE
@@ -488,6 +563,10 @@ uint8_t uc_lcd_grouped_pixel_actions_level;
 #ifdef LCD_MODE_BUFFERED
 /* Flag indicating if a data changed occurred (if a flush is really necessary) */
 uint8_t uc_lcd_data_changed;
+
+/* Range of changed columns (0-127) per page, empty if first > last */
+uint8_t uc_lcd_dirty_first_column[8];
+uint8_t uc_lcd_dirty_last_column[8];
 #endif
 
 
@@ -807,18 +886,163 @@ void uc_lcd_send_buffer_to_lcd() {
 
 #ifdef LCD_MODE_BUFFERED
 /*
- * Flushes the buffer: if changes have been made on the buffer, the complete
- * buffer will be sent to the LCD, otherwise nothing happens.
+ * Marks a column of a page as changed. Only changed columns are sent
+ * on the next flush.
+ *
+ * Params:
+ * 		- x: x coordinate over both chips (0-127).
+ * 		- page: index of vertical set of 8 pixels (0-7).
+ */
+void uc_lcd_mark_dirty(uint8_t x, uint8_t page) {
+	if ( x < uc_lcd_dirty_first_column[page] ) uc_lcd_dirty_first_column[page] = x;
+	if ( x > uc_lcd_dirty_last_column[page] ) uc_lcd_dirty_last_column[page] = x;
+
+	uc_lcd_data_changed = 1;
+}
+
+/*
+ * Marks a rectangle as changed, e.g. after modifying uc_lcd_buffer directly.
+ * Parts outside the display are ignored.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ */
+void uc_lcd_mark_rect_dirty(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+	if ( x > 127 || y > 63 || width == 0 || height == 0 ) return;
+
+	uint16_t right_x = x + width - 1;
+	uint16_t bottom_y = y + height - 1;
+	if ( right_x > 127 ) right_x = 127;
+	if ( bottom_y > 63 ) bottom_y = 63;
+
+	for ( uint8_t page = y/8; page <= bottom_y/8; page++ ) {
+		uc_lcd_mark_dirty(x, page);
+		uc_lcd_mark_dirty(right_x, page);
+	}
+}
+
+/*
+ * Marks the whole display as changed.
+ */
+void uc_lcd_mark_all_dirty() {
+	for ( uint8_t page = 0; page < 8; page++ ) {
+		uc_lcd_dirty_first_column[page] = 0;
+		uc_lcd_dirty_last_column[page] = 127;
+	}
+
+	uc_lcd_data_changed = 1;
+}
+
+/*
+ * Flushes the buffer: if changes have been made on the buffer, the changed
+ * columns of every page will be sent to the LCD, otherwise nothing happens.
  */
 void uc_lcd_flush() {
 	if ( uc_lcd_data_changed ) {
-		uc_lcd_send_buffer_to_lcd();
+		for ( uint8_t page = 0; page < 8; page++ ) {
+			uint8_t first = uc_lcd_dirty_first_column[page];
+			uint8_t last = uc_lcd_dirty_last_column[page];
+			if ( first > last ) continue;
+
+			uint16_t index = page * 64;
+
+			if ( first < 64 ) {
+				uint8_t end = last < 64 ? last : 63;
+
+				uc_lcd_set_page_chip_1(page);
+				uc_lcd_set_column_chip_1(first);
+				for ( uint8_t column = first; column <= end; column++ ) {
+					uc_lcd_send(1, 0, 1, uc_lcd_buffer[index + column]);
+				}
+			}
+
+			if ( last > 63 ) {
+				uint8_t start = first > 63 ? first : 64;
+
+				uc_lcd_set_page_chip_2(page);
+				uc_lcd_set_column_chip_2(start - 64);
+				for ( uint8_t column = start; column <= last; column++ ) {
+					uc_lcd_send(0, 1, 1, uc_lcd_buffer[512 + index + column - 64]);
+				}
+			}
+
+			uc_lcd_dirty_first_column[page] = 255;
+			uc_lcd_dirty_last_column[page] = 0;
+		}
 
 		uc_lcd_data_changed = 0;
 	}
 }
 #endif
 
+/*
+ * Retrieves the current raster operation.
+ *
+ * Returns:
+ * 		- uint8_t:	one of the LCD_RASTER_OP_ values.
+ */
+uint8_t uc_lcd_get_raster_op() {
+	return uc_lcd_raster_op;
+}
+
+/*
+ * Sets the raster operation used by all following pixel/byte writes.
+ * Clear, fill and inverting of the whole display are not affected.
+ *
+ * For a per call raster operation, remember the old one, set the new
+ * one, draw and restore the old one afterwards.
+ *
+ * Params:
+ * 		- uint8_t op:	one of the LCD_RASTER_OP_ values.
+ */
+void uc_lcd_set_raster_op(uint8_t op) {
+	uc_lcd_raster_op = op;
+}
+
+/*
+ * Combines a buffer byte with source pixels according to the current
+ * raster operation and inverted mode. Every write of pixel data into
+ * the buffer goes through here.
+ *
+ * Params:
+ * 		- data: current buffer byte.
+ * 		- source: pixel values (1 = black), only bits within mask are used.
+ * 		- mask: bits of data which shall be touched.
+ *
+ * Returns:
+ * 		- uint8_t:	new buffer byte.
+ */
+uint8_t uc_lcd_apply_raster_op(uint8_t data, uint8_t source, uint8_t mask) {
+	//Canvases are never inverted, only the display buffer
+	uint8_t inverted = uc_lcd_inverted && !uc_lcd_target;
+
+	source &= mask;
+
+	switch ( uc_lcd_raster_op ) {
+		case LCD_RASTER_OP_OR:
+			if ( inverted ) return data & ~source;
+			return data | source;
+
+		case LCD_RASTER_OP_AND_NOT:
+			if ( inverted ) return data | source;
+			return data & ~source;
+
+		case LCD_RASTER_OP_XOR:
+			return data ^ source;
+
+		case LCD_RASTER_OP_INVERT:
+			return data ^ mask;
+
+		default:
+			//In inverted mode a black pixel is a cleared bit
+			if ( inverted ) source ^= mask;
+			return (data & ~mask) | source;
+	}
+}
+
 /*
  * Retrieves the inverted status of the LCD graphics.
  *
@@ -850,7 +1074,7 @@ void uc_lcd_set_inverted(uint8_t invert) {
 		#endif
 
 		#ifdef LCD_MODE_BUFFERED
-			uc_lcd_data_changed = 1;
+			uc_lcd_mark_all_dirty();
 		#endif
 	}
 }
@@ -871,7 +1095,7 @@ void uc_lcd_clear() {
 	}
 
 	#ifdef LCD_MODE_BUFFERED
-		uc_lcd_data_changed = 1;
+		uc_lcd_mark_all_dirty();
 	#endif
 
 	#ifdef LCD_MODE_IMMEDIATE
@@ -894,7 +1118,7 @@ void uc_lcd_fill() {
 		}
 	}
 	#ifdef LCD_MODE_BUFFERED
-		uc_lcd_data_changed = 1;
+		uc_lcd_mark_all_dirty();
 	#endif
 
 	#ifdef LCD_MODE_IMMEDIATE
@@ -930,48 +1154,46 @@ void uc_lcd_leave_grouped_pixel_changes() {
 }
 #endif
 
-/**
- * Set a certain pixel value.
+/*
+ * Calculates the index of the buffer byte which holds the 8 pixels
+ * of a column within a page.
  *
  * Params:
- * 		- x: x coordinate of pixel.
- * 		- y: y coordinate of pixel.
- * 		- pixel: pixel value (0 or 1).
+ * 		- x: x coordinate over both chips (0-127).
+ * 		- page: index of vertical set of 8 pixels (0-7).
+ *
+ * Returns:
+ * 		- uint16_t: index of the byte in uc_lcd_buffer.
  */
-void uc_lcd_set_pixel(uint8_t x, uint8_t y, uint8_t pixel) {
-	if ( x > 127 ) return;
-	if ( y > 63 ) return;
-
-	uint8_t chip_1 = x < 64;
-	uint8_t column = x % 64;
-	uint8_t page = y/8;
-	uint8_t bit = y%8;
-
-	uint16_t buffer_index = column + (page * 64);
-	if ( !chip_1 ) buffer_index += 512;
+uint16_t uc_lcd_get_buffer_index(uint8_t x, uint8_t page) {
+	uint16_t buffer_index = (x % 64) + (page * 64);
+	if ( x > 63 ) buffer_index += 512;
 
-	//Retrieve data, modify pixel, apply inverting if necessary,
-	//send data in immediate mode, update changed flag in buffered mode.
-	uint8_t data = uc_lcd_buffer[buffer_index];
-
-	if ( uc_lcd_inverted ) {
-		if ( pixel ) data &= ~(1 << (bit));
-		else data |= (1 << (bit));
-	} else {
-		if ( pixel ) data |= (1 << (bit));
-		else data &= ~(1 << (bit));
-	}
+	return buffer_index;
+}
 
+/*
+ * Stores a modified byte in the buffer. In buffered mode the changed flag
+ * will be set, in immediate mode the byte will be sent to the LCD (unless
+ * grouped pixel changes are active).
+ *
+ * Params:
+ * 		- buffer_index: index of the byte in uc_lcd_buffer.
+ * 		- data: new 8 pixels (already inverted if necessary).
+ */
+void uc_lcd_store_byte(uint16_t buffer_index, uint8_t data) {
 	uc_lcd_buffer[buffer_index] = data;
 
-
 	#ifdef LCD_MODE_BUFFERED
-		uc_lcd_data_changed = 1;
+		uc_lcd_mark_dirty((buffer_index % 64) + (buffer_index < 512 ? 0 : 64), (buffer_index / 64) % 8);
 	#endif
 
 	#ifdef LCD_MODE_IMMEDIATE
 		if ( uc_lcd_grouped_pixel_actions_level == 0 ) {
-			if ( chip_1 ) {
+			uint8_t column = buffer_index % 64;
+			uint8_t page = (buffer_index / 64) % 8;
+
+			if ( buffer_index < 512 ) {
 				uc_lcd_set_page_chip_1(page);
 				uc_lcd_set_column_chip_1(column);
 				uc_lcd_write_chip1(data);
@@ -984,6 +1206,681 @@ void uc_lcd_set_pixel(uint8_t x, uint8_t y, uint8_t pixel) {
 	#endif
 }
 
+/*
+ * Calculates the amount of bytes a canvas needs.
+ *
+ * Params:
+ * 		- width: width of canvas in pixels.
+ * 		- height: height of canvas in pixels.
+ *
+ * Returns:
+ * 		- uint16_t:	amount of bytes.
+ */
+uint16_t uc_lcd_canvas_get_size(uint8_t width, uint8_t height) {
+	return (uint16_t)width * ((height + 7)/8);
+}
+
+/*
+ * Initializes a canvas and clears it (all pixels white).
+ *
+ * Params:
+ * 		- canvas: canvas to initialize.
+ * 		- buffer: memory of uc_lcd_canvas_get_size() bytes.
+ * 		- width: width of canvas in pixels.
+ * 		- height: height of canvas in pixels.
+ */
+void uc_lcd_canvas_init(uc_lcd_canvas *canvas, uint8_t *buffer, uint8_t width, uint8_t height) {
+	canvas->buffer = buffer;
+	canvas->width = width;
+	canvas->height = height;
+	canvas->layout = 0;
+
+	memset(buffer, 0, uc_lcd_canvas_get_size(width, height));
+}
+
+/*
+ * Redirects all following drawing operations (pixels, fills, blits, copies)
+ * into a canvas, so that every graphics, font and image function can draw
+ * off-screen. Clear, fill and inverting still affect the display only.
+ *
+ * Params:
+ * 		- canvas: canvas to draw into, 0 to draw into the display buffer again.
+ */
+void uc_lcd_set_target(uc_lcd_canvas *canvas) {
+	uc_lcd_target = canvas;
+}
+
+/*
+ * Retrieves the current render target.
+ *
+ * Returns:
+ * 		- uc_lcd_canvas*:	canvas drawing operations go to, 0 for the display.
+ */
+uc_lcd_canvas *uc_lcd_get_target() {
+	return uc_lcd_target;
+}
+
+/*
+ * Retrieves the width of the render target.
+ */
+uint8_t uc_lcd_get_target_width() {
+	return uc_lcd_target ? uc_lcd_target->width : 128;
+}
+
+/*
+ * Retrieves the height of the render target.
+ */
+uint8_t uc_lcd_get_target_height() {
+	return uc_lcd_target ? uc_lcd_target->height : 64;
+}
+
+/*
+ * Retrieves the byte of the render target which holds the 8 pixels of
+ * a column within a page.
+ *
+ * Params:
+ * 		- x: x coordinate of column.
+ * 		- page: index of vertical set of 8 pixels.
+ *
+ * Returns:
+ * 		- uint8_t*:	pointer to byte.
+ */
+uint8_t *uc_lcd_get_target_byte(uint8_t x, uint8_t page) {
+	if ( uc_lcd_target ) {
+		if ( uc_lcd_target->layout ) return &uc_lcd_target->buffer[uc_lcd_target->layout->get_index(x, page)];
+		return &uc_lcd_target->buffer[(uint16_t)page * uc_lcd_target->width + x];
+	}
+	return &uc_lcd_buffer[uc_lcd_get_buffer_index(x, page)];
+}
+
+/*
+ * Stores a modified byte of the render target. Bytes of the display buffer
+ * go through uc_lcd_store_byte (dirty tracking, immediate mode).
+ *
+ * Params:
+ * 		- byte: pointer retrieved by uc_lcd_get_target_byte.
+ * 		- data: new 8 pixels.
+ */
+void uc_lcd_store_target_byte(uint8_t *byte, uint8_t data) {
+	if ( uc_lcd_target ) *byte = data;
+	else uc_lcd_store_byte(byte - uc_lcd_buffer, data);
+}
+
+/*
+ * Restricts drawing operations (pixels, fills, blits) to a rectangle, e.g.
+ * to the bounds of a widget. Works on canvases too, the clip rectangle
+ * is kept when the render target changes. Restoring saved rectangles is
+ * not clipped.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels (0 clips everything).
+ * 		- height: height of rectangle in pixels (0 clips everything).
+ */
+void uc_lcd_set_clip(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+	uint16_t right_x = x + width - 1;
+	uint16_t bottom_y = y + height - 1;
+
+	uc_lcd_clip_left = x;
+	uc_lcd_clip_top = y;
+	uc_lcd_clip_right = (right_x > 255) ? 255 : right_x;
+	uc_lcd_clip_bottom = (bottom_y > 255) ? 255 : bottom_y;
+
+	if ( width == 0 || height == 0 ) {
+		//Empty: left of clip is right of its right edge
+		uc_lcd_clip_left = 255;
+		uc_lcd_clip_right = 0;
+	}
+}
+
+/*
+ * Removes the clip rectangle, drawing operations affect the whole
+ * render target again.
+ */
+void uc_lcd_reset_clip() {
+	uc_lcd_clip_left = 0;
+	uc_lcd_clip_top = 0;
+	uc_lcd_clip_right = 255;
+	uc_lcd_clip_bottom = 255;
+}
+
+/*
+ * Saves the current clip rectangle, so a function which clips its own
+ * drawing can put back the clip rectangle of its caller afterwards.
+ *
+ * Params:
+ * 		- clip: receives the clip rectangle.
+ */
+void uc_lcd_get_clip(uc_lcd_clip *clip) {
+	clip->left = uc_lcd_clip_left;
+	clip->top = uc_lcd_clip_top;
+	clip->right = uc_lcd_clip_right;
+	clip->bottom = uc_lcd_clip_bottom;
+}
+
+/*
+ * Sets a clip rectangle saved by uc_lcd_get_clip() again.
+ *
+ * Params:
+ * 		- clip: clip rectangle to restore.
+ */
+void uc_lcd_restore_clip(const uc_lcd_clip *clip) {
+	uc_lcd_clip_left = clip->left;
+	uc_lcd_clip_top = clip->top;
+	uc_lcd_clip_right = clip->right;
+	uc_lcd_clip_bottom = clip->bottom;
+}
+
+/*
+ * Restricts the current clip rectangle further to a rectangle, drawing
+ * operations then only affect pixels inside both. Unlike uc_lcd_set_clip()
+ * this keeps the clip rectangle of a caller (e.g. a parent widget).
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels (0 clips everything).
+ * 		- height: height of rectangle in pixels (0 clips everything).
+ */
+void uc_lcd_intersect_clip(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+	uint16_t right_x = x + width - 1;
+	uint16_t bottom_y = y + height - 1;
+
+	if ( width == 0 || height == 0 ) {
+		//Empty: left of clip is right of its right edge
+		uc_lcd_clip_left = 255;
+		uc_lcd_clip_right = 0;
+		return;
+	}
+
+	if ( x > uc_lcd_clip_left ) uc_lcd_clip_left = x;
+	if ( y > uc_lcd_clip_top ) uc_lcd_clip_top = y;
+	if ( right_x < uc_lcd_clip_right ) uc_lcd_clip_right = right_x;
+	if ( bottom_y < uc_lcd_clip_bottom ) uc_lcd_clip_bottom = bottom_y;
+}
+
+/*
+ * Intersects a rectangle with the render target and the clip rectangle.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ * 		- left, top, right, bottom: receive the visible part (inclusive).
+ *
+ * Returns:
+ * 		- uint8_t:	1 if a part is visible, 0 if not.
+ */
+uint8_t uc_lcd_clip_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+						 uint8_t *left, uint8_t *top, uint8_t *right, uint8_t *bottom) {
+
+	if ( width == 0 || height == 0 ) return 0;
+
+	uint16_t right_x = x + width - 1;
+	uint16_t bottom_y = y + height - 1;
+	if ( right_x >= uc_lcd_get_target_width() ) right_x = uc_lcd_get_target_width() - 1;
+	if ( bottom_y >= uc_lcd_get_target_height() ) bottom_y = uc_lcd_get_target_height() - 1;
+	if ( right_x > uc_lcd_clip_right ) right_x = uc_lcd_clip_right;
+	if ( bottom_y > uc_lcd_clip_bottom ) bottom_y = uc_lcd_clip_bottom;
+
+	*left = (x > uc_lcd_clip_left) ? x : uc_lcd_clip_left;
+	*top = (y > uc_lcd_clip_top) ? y : uc_lcd_clip_top;
+	*right = right_x;
+	*bottom = bottom_y;
+
+	return (*left <= right_x && *top <= bottom_y);
+}
+
+/**
+ * Set a certain pixel value.
+ *
+ * Params:
+ * 		- x: x coordinate of pixel.
+ * 		- y: y coordinate of pixel.
+ * 		- pixel: pixel value (0 or 1).
+ */
+void uc_lcd_set_pixel(uint8_t x, uint8_t y, uint8_t pixel) {
+	if ( x >= uc_lcd_get_target_width() ) return;
+	if ( y >= uc_lcd_get_target_height() ) return;
+	if ( x < uc_lcd_clip_left || x > uc_lcd_clip_right ) return;
+	if ( y < uc_lcd_clip_top || y > uc_lcd_clip_bottom ) return;
+
+	uint8_t *byte = uc_lcd_get_target_byte(x, y/8);
+
+	//Retrieve data, modify pixel according to raster operation and inverting,
+	//send data in immediate mode, update changed flag in buffered mode.
+	uint8_t data = *byte;
+	uint8_t new_data = uc_lcd_apply_raster_op(data, pixel ? 0xFF : 0x00, (1 << (y%8)));
+
+	if ( new_data != data ) uc_lcd_store_target_byte(byte, new_data);
+}
+
+/*
+ * Fills a rectangle with a repeating 8x8 pattern. Instead of setting every
+ * pixel on its own, up to 8 pixels of a column are modified at once by
+ * masking whole buffer bytes. The current raster operation is applied.
+ * Only bytes which really change are stored, so in immediate mode nothing
+ * is sent for untouched bytes.
+ *
+ * The pattern is anchored to the display: byte n holds the pixels of all
+ * columns with x%8 == n, bit m the pixel of rows with y%8 == m. As pages
+ * are 8 rows high, a pattern byte is exactly the source of a buffer byte.
+ *
+ * Parts of the rectangle outside the render target or the clip rectangle
+ * are clipped.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ * 		- pattern: 8 column bytes in RAM (1 = black).
+ */
+void uc_lcd_fill_rect_pattern(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *pattern) {
+	uint8_t right_x, bottom_y;
+	if ( !uc_lcd_clip_rect(x, y, width, height, &x, &y, &right_x, &bottom_y) ) return;
+
+	uint8_t first_page = y/8;
+	uint8_t last_page = bottom_y/8;
+
+	for ( uint8_t page = first_page; page <= last_page; page++ ) {
+		uint8_t mask = 0xFF;
+		if ( page == first_page ) mask &= (0xFF << (y%8));
+		if ( page == last_page ) mask &= (0xFF >> (7 - (bottom_y%8)));
+
+		for ( uint8_t column = x; column <= right_x; column++ ) {
+			uint8_t *byte = uc_lcd_get_target_byte(column, page);
+			uint8_t data = *byte;
+			uint8_t new_data = uc_lcd_apply_raster_op(data, pattern[column % 8], mask);
+
+			if ( new_data != data ) uc_lcd_store_target_byte(byte, new_data);
+		}
+	}
+}
+
+/*
+ * Fills a rectangle with the given pixel value. Works byte wise like
+ * uc_lcd_fill_rect_pattern, see there for details.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ * 		- pixel: pixel value (0 or 1).
+ */
+void uc_lcd_fill_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t pixel) {
+	uint8_t source = pixel ? 0xFF : 0x00;
+	uint8_t solid[8] = { source, source, source, source, source, source, source, source };
+
+	uc_lcd_fill_rect_pattern(x, y, width, height, solid);
+}
+
+/*
+ * Retrieves a certain pixel value from the render target.
+ *
+ * Params:
+ * 		- x: x coordinate of pixel.
+ * 		- y: y coordinate of pixel.
+ *
+ * Returns:
+ * 		- uint8_t:	pixel value (0 or 1), 0 for pixels outside the render target.
+ */
+uint8_t uc_lcd_get_pixel(uint8_t x, uint8_t y) {
+	if ( x >= uc_lcd_get_target_width() ) return 0;
+	if ( y >= uc_lcd_get_target_height() ) return 0;
+
+	uint8_t bit = (*uc_lcd_get_target_byte(x, y/8) >> (y%8)) & 0x01;
+	return (uc_lcd_inverted && !uc_lcd_target) ? !bit : bit;
+}
+
+/*
+ * Copies a rectangle of the render target to another position. Source and
+ * destination may overlap. The bytes are moved as they are, the raster
+ * operation is not applied. Only destination bytes that really change
+ * are stored (marked dirty / sent to the LCD).
+ *
+ * If the rectangle and both y coordinates are page aligned (multiples of 8),
+ * whole buffer rows are moved with memmove (buffered mode or canvas).
+ * Otherwise every column is read into a temporary copy and the destination
+ * bytes are assembled by shifting two neighbouring source bytes across the
+ * page boundary.
+ *
+ * Parts of source or destination outside the render target are clipped,
+ * like every drawing operation the destination is clipped to the clip
+ * rectangle too (the source is not).
+ *
+ * Params:
+ * 		- src_x: x coordinate of left column of source.
+ * 		- src_y: y coordinate of top row of source.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ * 		- dst_x: x coordinate of left column of destination.
+ * 		- dst_y: y coordinate of top row of destination.
+ */
+void uc_lcd_copy_rect(uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t dst_x, uint8_t dst_y) {
+	uint8_t target_width = uc_lcd_get_target_width();
+	uint8_t target_height = uc_lcd_get_target_height();
+
+	if ( src_x >= target_width || dst_x >= target_width ) return;
+	if ( src_y >= target_height || dst_y >= target_height ) return;
+
+	if ( width > target_width - src_x ) width = target_width - src_x;
+	if ( width > target_width - dst_x ) width = target_width - dst_x;
+	if ( height > target_height - src_y ) height = target_height - src_y;
+	if ( height > target_height - dst_y ) height = target_height - dst_y;
+	if ( width == 0 || height == 0 ) return;
+
+	//Only destination pixels inside the clip rectangle are written
+	if ( dst_x > uc_lcd_clip_right || dst_y > uc_lcd_clip_bottom ) return;
+	if ( dst_x < uc_lcd_clip_left ) {
+		uint8_t skip = uc_lcd_clip_left - dst_x;
+		if ( skip >= width ) return;
+		src_x += skip;
+		dst_x += skip;
+		width -= skip;
+	}
+	if ( dst_y < uc_lcd_clip_top ) {
+		uint8_t skip = uc_lcd_clip_top - dst_y;
+		if ( skip >= height ) return;
+		src_y += skip;
+		dst_y += skip;
+		height -= skip;
+	}
+	if ( width > uc_lcd_clip_right - dst_x + 1 ) width = uc_lcd_clip_right - dst_x + 1;
+	if ( height > uc_lcd_clip_bottom - dst_y + 1 ) height = uc_lcd_clip_bottom - dst_y + 1;
+
+	uint8_t page_aligned = (src_y % 8) == 0 && (dst_y % 8) == 0 && (height % 8) == 0;
+
+	#ifdef LCD_MODE_IMMEDIATE
+		//Every changed byte of the display has to be sent
+		if ( !uc_lcd_target ) page_aligned = 0;
+	#endif
+
+	if ( page_aligned ) {
+		uint8_t pages = height/8;
+		uint8_t src_page = src_y/8;
+		uint8_t dst_page = dst_y/8;
+
+		//Rows of the display are split into the two chips, canvas rows
+		//only if their layout says so
+		uint8_t segment = 64;
+		if ( uc_lcd_target ) segment = uc_lcd_target->layout ? uc_lcd_target->layout->run_width : 0;
+
+		for ( uint8_t i = 0; i < pages; i++ ) {
+			//Moving down: start with bottom row to not overwrite source rows
+			uint8_t row = (dst_page > src_page) ? (pages - 1 - i) : i;
+
+			//Runs must not cross chip boundaries, so they are split. Moving
+			//right: start with the right most run.
+			uint8_t done = 0;
+			while ( done < width ) {
+				uint8_t offset, run;
+
+				if ( dst_x > src_x ) {
+					uint8_t end = width - done;
+					run = end;
+					if ( segment ) {
+						if ( run > ((src_x + end - 1) % segment) + 1 ) run = ((src_x + end - 1) % segment) + 1;
+						if ( run > ((dst_x + end - 1) % segment) + 1 ) run = ((dst_x + end - 1) % segment) + 1;
+					}
+					offset = end - run;
+				} else {
+					offset = done;
+					run = width - done;
+					if ( segment ) {
+						if ( run > segment - ((src_x + offset) % segment) ) run = segment - ((src_x + offset) % segment);
+						if ( run > segment - ((dst_x + offset) % segment) ) run = segment - ((dst_x + offset) % segment);
+					}
+				}
+
+				memmove(uc_lcd_get_target_byte(dst_x + offset, dst_page + row),
+						uc_lcd_get_target_byte(src_x + offset, src_page + row),
+						run);
+
+				done += run;
+			}
+		}
+
+		#ifdef LCD_MODE_BUFFERED
+			if ( !uc_lcd_target ) uc_lcd_mark_rect_dirty(dst_x, dst_y, width, height);
+		#endif
+		return;
+	}
+
+	int16_t shift = (int16_t)dst_y - (int16_t)src_y;
+	uint8_t bottom_y = dst_y + height - 1;
+	uint8_t first_page = dst_y/8;
+	uint8_t last_page = bottom_y/8;
+	uint8_t target_pages = (target_height + 7)/8;
+
+	for ( uint8_t i = 0; i < width; i++ ) {
+		//Moving right: start with right most column to not overwrite source columns
+		uint8_t offset = (dst_x > src_x) ? (width - 1 - i) : i;
+
+		uint8_t column[32];
+		for ( uint8_t page = 0; page < target_pages; page++ ) {
+			column[page] = *uc_lcd_get_target_byte(src_x + offset, page);
+		}
+
+		for ( uint8_t page = first_page; page <= last_page; page++ ) {
+			uint8_t mask = 0xFF;
+			if ( page == first_page ) mask &= (0xFF << (dst_y%8));
+			if ( page == last_page ) mask &= (0xFF >> (7 - (bottom_y%8)));
+
+			//Source row of first bit of this destination page
+			int16_t src_row = (int16_t)page*8 - shift;
+			int8_t src_page = src_row >> 3;
+			uint8_t src_bit = src_row & 0x07;
+
+			uint16_t window = 0;
+			if ( src_page >= 0 && src_page < target_pages ) window = column[src_page];
+			if ( src_page + 1 >= 0 && src_page + 1 < target_pages ) window |= ((uint16_t)column[src_page + 1]) << 8;
+			uint8_t source = window >> src_bit;
+
+			uint8_t *byte = uc_lcd_get_target_byte(dst_x + offset, page);
+			uint8_t data = *byte;
+			uint8_t new_data = (data & ~mask) | (source & mask);
+
+			if ( new_data != data ) uc_lcd_store_target_byte(byte, new_data);
+		}
+	}
+}
+
+/*
+ * Draws a bitmap stored in page layout: the bitmap consists of
+ * (height+7)/8 rows of width bytes, every byte holds 8 vertical pixels
+ * of a column (LSB is the top pixel). This is the layout of the display
+ * buffer, so at page aligned y coordinates every bitmap byte is combined
+ * with exactly one buffer byte. Otherwise a buffer byte is assembled from
+ * two neighbouring bitmap bytes shifted across the page boundary.
+ *
+ * The optional mask has the same layout. Only pixels with mask bit 1 are
+ * touched, which allows sprites of any shape. Without mask all pixels of
+ * the rectangle are touched. The current raster operation is applied.
+ *
+ * Parts outside the render target or the clip rectangle are clipped.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of bitmap in pixels.
+ * 		- height: height of bitmap in pixels.
+ * 		- bitmap: pixel bytes (1 = black).
+ * 		- mask: mask bytes or 0.
+ * 		- progmem: 1 if bitmap and mask are stored in progmem, 0 if in RAM.
+ */
+void uc_lcd_blit(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+				 const uint8_t *bitmap, const uint8_t *mask, uint8_t progmem) {
+
+	uint8_t left, top, right_x, bottom_y;
+	if ( !uc_lcd_clip_rect(x, y, width, height, &left, &top, &right_x, &bottom_y) ) return;
+
+	uint8_t src_pages = (height + 7)/8;
+	uint8_t shift = y%8;
+	uint8_t first_page = y/8;
+	uint8_t last_page = bottom_y/8;
+
+	for ( uint8_t page = top/8; page <= last_page; page++ ) {
+		uint8_t row_mask = 0xFF;
+		if ( page == top/8 ) row_mask &= (0xFF << (top%8));
+		if ( page == last_page ) row_mask &= (0xFF >> (7 - (bottom_y%8)));
+
+		//Bitmap rows covering this page: upper part from row k-1, lower part from row k
+		uint8_t k = page - first_page;
+		uint8_t has_upper = (shift > 0 && k > 0);
+		uint8_t has_lower = (k < src_pages);
+		uint16_t upper_index = (k-1) * width;
+		uint16_t lower_index = k * width;
+
+		for ( uint8_t i = left - x; i <= right_x - x; i++ ) {
+			uint8_t source = 0;
+			uint8_t source_mask = mask ? 0 : 0xFF;
+
+			if ( has_lower ) {
+				source = (progmem ? pgm_read_byte(&bitmap[lower_index + i]) : bitmap[lower_index + i]) << shift;
+				if ( mask ) source_mask = (progmem ? pgm_read_byte(&mask[lower_index + i]) : mask[lower_index + i]) << shift;
+			}
+			if ( has_upper ) {
+				source |= (progmem ? pgm_read_byte(&bitmap[upper_index + i]) : bitmap[upper_index + i]) >> (8 - shift);
+				if ( mask ) source_mask |= (progmem ? pgm_read_byte(&mask[upper_index + i]) : mask[upper_index + i]) >> (8 - shift);
+			}
+
+			uint8_t *byte = uc_lcd_get_target_byte(x + i, page);
+			uint8_t data = *byte;
+			uint8_t new_data = uc_lcd_apply_raster_op(data, source, source_mask & row_mask);
+
+			if ( new_data != data ) uc_lcd_store_target_byte(byte, new_data);
+		}
+	}
+}
+
+/*
+ * Composites a canvas into the render target (normally the display, but
+ * canvases can also be layered onto each other). Uses uc_lcd_blit, so
+ * at page aligned y coordinates every canvas byte is combined with exactly
+ * one target byte, and the current raster operation is applied.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- canvas: canvas in page layout to draw (must not be the render target).
+ * 		- mask: canvas of same size, pixels with value 1 are drawn, or 0 to draw all pixels.
+ */
+void uc_lcd_blit_canvas(uint8_t x, uint8_t y, const uc_lcd_canvas *canvas, const uc_lcd_canvas *mask) {
+	uc_lcd_blit(x, y, canvas->width, canvas->height, canvas->buffer, mask ? mask->buffer : 0, 0);
+}
+
+/*
+ * Calculates the amount of bytes uc_lcd_save_rect needs for a rectangle.
+ * All pages touched by the rectangle are saved completely.
+ *
+ * Params:
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ *
+ * Returns:
+ * 		- uint16_t:	amount of bytes.
+ */
+uint16_t uc_lcd_get_saved_rect_size(uint8_t y, uint8_t width, uint8_t height) {
+	if ( height == 0 ) return 0;
+	return (uint16_t)width * (((y + height - 1)/8) - (y/8) + 1);
+}
+
+/*
+ * Saves the bytes of all pages touched by a rectangle, e.g. the background
+ * under a sprite. The bytes are stored page by page, each page width bytes.
+ * Bytes outside the render target are skipped.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ * 		- destination: memory of uc_lcd_get_saved_rect_size() bytes.
+ */
+void uc_lcd_save_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t *destination) {
+	if ( height == 0 ) return;
+
+	uint8_t target_width = uc_lcd_get_target_width();
+	uint8_t target_pages = (uc_lcd_get_target_height() + 7)/8;
+	uint8_t first_page = y/8;
+	uint8_t last_page = (y + height - 1)/8;
+	uint16_t index = 0;
+
+	for ( uint8_t page = first_page; page <= last_page; page++ ) {
+		for ( uint8_t i = 0; i < width; i++ ) {
+			if ( page < target_pages && x + i < target_width ) destination[index] = *uc_lcd_get_target_byte(x + i, page);
+			index++;
+		}
+	}
+}
+
+/*
+ * Writes bytes saved by uc_lcd_save_rect back. Only the rows of the
+ * rectangle are restored, pixels above or below it in the same pages
+ * keep their current value. The raster operation is not applied, only
+ * bytes which really change are stored.
+ *
+ * Params:
+ * 		- x: x coordinate of left column.
+ * 		- y: y coordinate of top row.
+ * 		- width: width of rectangle in pixels.
+ * 		- height: height of rectangle in pixels.
+ * 		- source: bytes saved by uc_lcd_save_rect.
+ */
+void uc_lcd_restore_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *source) {
+	if ( height == 0 ) return;
+
+	uint8_t target_width = uc_lcd_get_target_width();
+	uint8_t target_pages = (uc_lcd_get_target_height() + 7)/8;
+	uint8_t first_page = y/8;
+	uint8_t last_page = (y + height - 1)/8;
+	uint16_t index = 0;
+
+	for ( uint8_t page = first_page; page <= last_page; page++ ) {
+		uint8_t mask = 0xFF;
+		if ( page == first_page ) mask &= (0xFF << (y%8));
+		if ( page == last_page ) mask &= (0xFF >> (7 - ((y + height - 1)%8)));
+
+		for ( uint8_t i = 0; i < width; i++ ) {
+			if ( page < target_pages && x + i < target_width ) {
+				uint8_t *byte = uc_lcd_get_target_byte(x + i, page);
+				uint8_t data = *byte;
+				uint8_t new_data = (data & ~mask) | (source[index] & mask);
+
+				if ( new_data != data ) uc_lcd_store_target_byte(byte, new_data);
+			}
+			index++;
+		}
+	}
+}
+
+/*
+ * Calculates a Fletcher-16 checksum of the pixels of the display buffer,
+ * independent of inverting. Drawing the same scene once with the fast
+ * paths and once with LCD_API_REFERENCE_PATHS defined must result in the
+ * same checksum.
+ *
+ * Returns:
+ * 		- uint16_t:	checksum.
+ */
+uint16_t uc_lcd_get_buffer_checksum() {
+	uint16_t sum_1 = 0;
+	uint16_t sum_2 = 0;
+
+	for ( uint16_t i = 0; i < 1024; i++ ) {
+		uint8_t data = uc_lcd_inverted ? ~uc_lcd_buffer[i] : uc_lcd_buffer[i];
+		sum_1 = (sum_1 + data) % 255;
+		sum_2 = (sum_2 + sum_1) % 255;
+	}
+
+	return (sum_2 << 8) | sum_1;
+}
+
 /*
  * Resets LCD setup. Resets startline, page and column to zero and clears screen.
  */
@@ -1076,6 +1973,39 @@ void uc_lcd_init() {
  * 		- uint8_t	LCD_API_IS_INVERTED()
  * 		- void		LCD_API_SET_INVERTED(uint8_t inverted) --> good for blue/white displays
  * 		- void		LCD_API_SET_PIXEL(uint8_t x, uint8_t y, uint8_t pixel)
+ *
+ * Optional API calls (graphics, fonts and images fall back to
+ * LCD_API_SET_PIXEL if they are missing):
+ * 		- void		LCD_API_FILL_RECT(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t pixel)
+ * 		- void		LCD_API_FILL_RECT_PATTERN(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *pattern)
+ * 		- uint8_t	LCD_API_GET_RASTER_OP()
+ * 		- void		LCD_API_SET_RASTER_OP(uint8_t op)
+ * 		- uint8_t	LCD_API_GET_PIXEL(uint8_t x, uint8_t y)
+ * 		- void		LCD_API_COPY_RECT(uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t dst_x, uint8_t dst_y)
+ * 		- void		LCD_API_BLIT(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *bitmap, const uint8_t *mask, uint8_t progmem)
+ * 		- uint16_t	LCD_API_GET_SAVED_RECT_SIZE(uint8_t y, uint8_t width, uint8_t height)
+ * 		- void		LCD_API_SAVE_RECT(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t *destination)
+ * 		- void		LCD_API_RESTORE_RECT(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *source)
+ * 		- void		LCD_API_SET_TARGET(uc_lcd_canvas *canvas)
+ * 		- uc_lcd_canvas* LCD_API_GET_TARGET()
+ * 		- void		LCD_API_BLIT_CANVAS(uint8_t x, uint8_t y, const uc_lcd_canvas *canvas, const uc_lcd_canvas *mask)
+ * 		- uint8_t	LCD_API_GET_TARGET_WIDTH()
+ * 		- uint8_t	LCD_API_GET_TARGET_HEIGHT()
+ * 		- uint16_t	LCD_API_GET_BUFFER_CHECKSUM()
+ * 		- void		LCD_API_SET_CLIP(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+ * 		- void		LCD_API_RESET_CLIP()
+ * 		- 			LCD_API_CLIP --> type holding a saved clip rectangle (left, top, right, bottom, inclusive)
+ * 		- void		LCD_API_GET_CLIP(LCD_API_CLIP *clip)
+ * 		- void		LCD_API_RESTORE_CLIP(const LCD_API_CLIP *clip)
+ * 		- void		LCD_API_INTERSECT_CLIP(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+ * 		- 			LCD_API_FAST_BLIT --> flag, LCD_API_BLIT may replace drawing pixel by pixel
+ *
+ * Defining LCD_API_REFERENCE_PATHS before including this header file
+ * leaves out the optional calls which only speed up drawing (byte wise
+ * fills and copies, blitting of images and glyphs). Graphics, fonts and
+ * images then draw every pixel through LCD_API_SET_PIXEL. Drawing the
+ * same scene with and without it and comparing LCD_API_GET_BUFFER_CHECKSUM()
+ * verifies that the fast paths set exactly the same pixels.
  */
 
 #define LCD_API_WIDTH					128
@@ -1087,9 +2017,36 @@ void uc_lcd_init() {
 #define LCD_API_IS_INVERTED() 			uc_lcd_is_inverted()
 #define LCD_API_SET_INVERTED(invert) 	uc_lcd_set_inverted(invert)
 #define LCD_API_SET_PIXEL(x, y, pixel) 	uc_lcd_set_pixel(x, y, pixel)
+#define LCD_API_GET_RASTER_OP()			uc_lcd_get_raster_op()
+#define LCD_API_SET_RASTER_OP(op)		uc_lcd_set_raster_op(op)
+#define LCD_API_GET_PIXEL(x, y)			uc_lcd_get_pixel(x, y)
+#define LCD_API_BLIT(x, y, width, height, bitmap, mask, progmem) uc_lcd_blit(x, y, width, height, bitmap, mask, progmem)
+#define LCD_API_GET_SAVED_RECT_SIZE(y, width, height) uc_lcd_get_saved_rect_size(y, width, height)
+#define LCD_API_SAVE_RECT(x, y, width, height, destination) uc_lcd_save_rect(x, y, width, height, destination)
+#define LCD_API_RESTORE_RECT(x, y, width, height, source) uc_lcd_restore_rect(x, y, width, height, source)
+#define LCD_API_SET_TARGET(canvas)		uc_lcd_set_target(canvas)
+#define LCD_API_GET_TARGET()			uc_lcd_get_target()
+#define LCD_API_BLIT_CANVAS(x, y, canvas, mask) uc_lcd_blit_canvas(x, y, canvas, mask)
+#define LCD_API_GET_TARGET_WIDTH()		uc_lcd_get_target_width()
+#define LCD_API_GET_TARGET_HEIGHT()		uc_lcd_get_target_height()
+#define LCD_API_GET_BUFFER_CHECKSUM()	uc_lcd_get_buffer_checksum()
+#define LCD_API_SET_CLIP(x, y, width, height) uc_lcd_set_clip(x, y, width, height)
+#define LCD_API_RESET_CLIP()			uc_lcd_reset_clip()
+#define LCD_API_CLIP					uc_lcd_clip
+#define LCD_API_GET_CLIP(clip)			uc_lcd_get_clip(clip)
+#define LCD_API_RESTORE_CLIP(clip)		uc_lcd_restore_clip(clip)
+#define LCD_API_INTERSECT_CLIP(x, y, width, height) uc_lcd_intersect_clip(x, y, width, height)
+
+#ifndef LCD_API_REFERENCE_PATHS
+	#define LCD_API_FILL_RECT(x, y, width, height, pixel) uc_lcd_fill_rect(x, y, width, height, pixel)
+	#define LCD_API_FILL_RECT_PATTERN(x, y, width, height, pattern) uc_lcd_fill_rect_pattern(x, y, width, height, pattern)
+	#define LCD_API_COPY_RECT(src_x, src_y, width, height, dst_x, dst_y) uc_lcd_copy_rect(src_x, src_y, width, height, dst_x, dst_y)
+	#define LCD_API_FAST_BLIT
+#endif
 
 #ifdef LCD_MODE_BUFFERED
 	#define LCD_API_FLUSH() 			uc_lcd_flush()
+	#define LCD_API_MARK_RECT_DIRTY(x, y, width, height) uc_lcd_mark_rect_dirty(x, y, width, height)
 #endif
 
 #ifdef LCD_MODE_IMMEDIATE
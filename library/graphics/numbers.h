@@ -0,0 +1,248 @@
+/**
+ * This library draws integer and fixed point numbers without printf and
+ * without heap, e.g. readings of sensors.
+ *
+ * Fixed point numbers are passed as integers scaled by 10^decimals:
+ * 214 with 1 decimal is shown as "21.4". Numbers are right aligned within
+ * a minimum width and padded with spaces or zeros.
+ *
+ * A field shows a number at a fixed position and remembers the characters
+ * it shows. Updating it redraws only the character cells which changed:
+ * a temperature going from 21.4 to 21.5 redraws one cell. Cells are as
+ * wide as the font width plus one pixel gap, also for proportional fonts.
+ * Numbers wider than a field are shown as dashes.
+ *
+ * Capacity can be changed by defining following macro before including
+ * this header file:
+ * 		- UC_NUMBERS_MAX_LENGTH: buffer size for formatted numbers and
+ * 		  fields including terminating zero (default 14, at least 13 for
+ * 		  "-2147483.648").
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_GRAPHICS_NUMBERS_H_
+#define UC_AVR_GRAPHICS_NUMBERS_H_
+
+#ifndef LCD_API_SET_PIXEL
+#error "µC-Graphics numbers library does require LCD_API_SET_PIXEL makro to be set, in order to draw."
+#endif
+
+#include <avr/pgmspace.h>
+#include "../graphics/graphics.h"
+#include "../graphics/fonts.h"
+
+#ifndef UC_NUMBERS_MAX_LENGTH
+	//Change here or set macro before including this header file!
+	#define UC_NUMBERS_MAX_LENGTH 14
+#endif
+
+#if UC_NUMBERS_MAX_LENGTH < 13
+#error "µC-Graphics numbers library does require UC_NUMBERS_MAX_LENGTH to be at least 13 (sign, 10 digits, decimal point and terminating zero)."
+#endif
+
+struct uc_numbers_field_struct {
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;					//amount of character cells
+	uint8_t decimals;
+	char pad;						//' ' or '0'
+	const uint8_t *progmem_font;
+	char shown[UC_NUMBERS_MAX_LENGTH];	//characters currently drawn, 0 if cell has to be drawn
+};
+
+typedef struct uc_numbers_field_struct uc_numbers_field;
+
+/**
+ * Formats a number right aligned into a string.
+ *
+ * params:
+ * 		- value: number, scaled by 10^decimals for fixed point numbers
+ * 		- decimals: amount of digits after the decimal point (0: integer)
+ * 		- width: minimum amount of characters, shorter numbers are padded on the left
+ * 		- pad: ' ' pads before the sign, '0' pads between sign and digits
+ * 		- string: receives the number, UC_NUMBERS_MAX_LENGTH bytes
+ *
+ * returns: amount of characters without terminating zero.
+ */
+uint8_t uc_numbers_format(int32_t value, uint8_t decimals, uint8_t width, char pad, char *string) {
+	char digits[10];
+	uint8_t count = 0;
+	uint32_t magnitude = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+
+	if ( decimals > 9 ) decimals = 9;
+	if ( width > UC_NUMBERS_MAX_LENGTH - 1 ) width = UC_NUMBERS_MAX_LENGTH - 1;
+
+	//At least one digit before the decimal point
+	do {
+		digits[count++] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while ( magnitude || count <= decimals );
+
+	uint8_t length = count + (decimals ? 1 : 0) + (value < 0 ? 1 : 0);
+	uint8_t padding = (length < width) ? width - length : 0;
+	uint8_t index = 0;
+
+	if ( pad != '0' ) {
+		while ( padding ) {
+			string[index++] = pad;
+			padding--;
+		}
+	}
+
+	if ( value < 0 ) string[index++] = '-';
+
+	while ( padding ) {
+		string[index++] = '0';
+		padding--;
+	}
+
+	while ( count ) {
+		if ( count == decimals ) string[index++] = '.';
+		string[index++] = digits[--count];
+	}
+
+	string[index] = 0;
+	return index;
+}
+
+/**
+ * Draws a number, see uc_numbers_format().
+ *
+ * params:
+ * 		- value: number, scaled by 10^decimals for fixed point numbers
+ * 		- decimals: amount of digits after the decimal point (0: integer)
+ * 		- width: minimum amount of characters, shorter numbers are padded on the left
+ * 		- pad: ' ' pads before the sign, '0' pads between sign and digits
+ * 		- x: x coordinate to start drawing
+ * 		- y: y coordinate to start drawing
+ * 		- draw_white_pixels: if 1, white pixels of characters will be drawn too, if 0 only black pixels will be drawn
+ * 		- progmem_font: font in progmem
+ */
+void uc_numbers_draw(int32_t value,
+					 uint8_t decimals,
+					 uint8_t width,
+					 char pad,
+					 uint8_t x,
+					 uint8_t y,
+					 uint8_t draw_white_pixels,
+					 const uint8_t *progmem_font) {
+
+	char string[UC_NUMBERS_MAX_LENGTH];
+	uc_numbers_format(value, decimals, width, pad, string);
+	uc_fonts_draw_string(string, x, y, draw_white_pixels, draw_white_pixels, progmem_font);
+}
+
+/**
+ * Initializes a field. Nothing is drawn until the first update.
+ *
+ * params:
+ * 		- field: field to initialize
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: amount of character cells, including sign and decimal point
+ * 		- decimals: amount of digits after the decimal point (0: integer)
+ * 		- pad: ' ' pads before the sign, '0' pads between sign and digits
+ * 		- progmem_font: font in progmem
+ */
+void uc_numbers_field_init(uc_numbers_field *field,
+						   uint8_t x,
+						   uint8_t y,
+						   uint8_t width,
+						   uint8_t decimals,
+						   char pad,
+						   const uint8_t *progmem_font) {
+
+	if ( width > UC_NUMBERS_MAX_LENGTH - 1 ) width = UC_NUMBERS_MAX_LENGTH - 1;
+
+	field->x = x;
+	field->y = y;
+	field->width = width;
+	field->decimals = decimals;
+	field->pad = pad;
+	field->progmem_font = progmem_font;
+	memset(field->shown, 0, UC_NUMBERS_MAX_LENGTH);
+}
+
+/**
+ * Makes the next update draw all cells of a field, e.g. after the screen
+ * has been cleared.
+ *
+ * params:
+ * 		- field: field to invalidate
+ */
+void uc_numbers_field_invalidate(uc_numbers_field *field) {
+	memset(field->shown, 0, UC_NUMBERS_MAX_LENGTH);
+}
+
+/*
+ * Draws a character into a cell of a field, the cell is cleared.
+ */
+void uc_numbers_field_draw_cell(uc_numbers_field *field, uint8_t cell, char char_code) {
+	uint8_t char_width = uc_fonts_get_char_width(field->progmem_font);
+	uint8_t x = field->x + cell * (char_width + 1);
+
+	if ( uc_fonts_get_settings(field->progmem_font) & UC_FONTS_SETTINGS_BIT_PR_MASK ) {
+		uc_graphics_fill_rect(x, field->y, char_width, uc_fonts_get_char_height(field->progmem_font), 0);
+		uc_fonts_draw_char(char_code, x, field->y, 0, field->progmem_font);
+	} else {
+		//White pixels of fixed width characters cover the whole cell
+		uc_fonts_draw_char(char_code, x, field->y, 1, field->progmem_font);
+	}
+}
+
+/**
+ * Shows a number in a field, only cells whose character changed are
+ * redrawn.
+ *
+ * params:
+ * 		- field: field to update
+ * 		- value: number, scaled by 10^decimals for fixed point numbers
+ *
+ * returns: amount of redrawn cells.
+ */
+uint8_t uc_numbers_field_update(uc_numbers_field *field, int32_t value) {
+	char string[UC_NUMBERS_MAX_LENGTH];
+	uint8_t length = uc_numbers_format(value, field->decimals, field->width, field->pad, string);
+
+	if ( length > field->width ) {
+		memset(string, '-', field->width);
+	}
+
+	uint8_t redrawn = 0;
+
+	for ( uint8_t cell = 0; cell < field->width; cell++ ) {
+		if ( string[cell] == field->shown[cell] ) continue;
+
+		uc_numbers_field_draw_cell(field, cell, string[cell]);
+		field->shown[cell] = string[cell];
+		redrawn++;
+	}
+
+	return redrawn;
+}
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * This library moves a few small bitmaps (sprites) like cursors or
+ * indicators over a static background without redrawing the background.
+ *
+ * The sprite table has a fixed capacity. Before a sprite is drawn, the
+ * buffer bytes under it are saved into a small arena, and when the sprite
+ * is moved or hidden, exactly these bytes are written back. All bytes
+ * under a sprite are stored, but restoring skips the bytes that do not
+ * change and does not mark them dirty, so moving a 16x16 sprite touches
+ * only the few buffer pages under its old and new position.
+ *
+ * Sprite bitmaps and masks are stored in PROGMEM in page layout (see
+ * uc_lcd_blit): (height+7)/8 rows of width bytes, every byte holds 8
+ * vertical pixels of a column, LSB is the top pixel. Mask bit 1 means the
+ * pixel belongs to the sprite, so sprites can have any shape.
+ *
+ * Usage:
+ * 		- Draw the background.
+ * 		- Add sprites with uc_sprites_add().
+ * 		- Move, show and hide them, then call uc_sprites_update().
+ * 		- After uc_sprites_update() uc_sprites_dirty_rects holds the
+ * 		  regions which changed (merged if they overlap).
+ * 		- Before drawing on the background under visible sprites, hide
+ * 		  them and call uc_sprites_update().
+ *
+ * Capacity can be changed by defining following macros before including
+ * this header file:
+ * 		- UC_SPRITES_MAX: amount of sprites (default 4).
+ * 		- UC_SPRITES_ARENA_SIZE: bytes for saved backgrounds (default 128).
+ * 		  A sprite needs width * ((height+14)/8) bytes, 48 for 16x16.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_GRAPHICS_SPRITES_H_
+#define UC_AVR_GRAPHICS_SPRITES_H_
+
+#if !defined(LCD_API_BLIT) || !defined(LCD_API_SAVE_RECT) || !defined(LCD_API_RESTORE_RECT)
+#error "µC-Graphics sprites library does require LCD_API_BLIT, LCD_API_SAVE_RECT and LCD_API_RESTORE_RECT makros to be set."
+#endif
+
+#include <avr/pgmspace.h>
+#include "../graphics/graphics.h"
+
+#ifndef UC_SPRITES_MAX
+	//Change here or set macro before including this header file!
+	#define UC_SPRITES_MAX 4
+#endif
+
+#ifndef UC_SPRITES_ARENA_SIZE
+	//Change here or set macro before including this header file!
+	#define UC_SPRITES_ARENA_SIZE 128
+#endif
+
+#define UC_SPRITES_FLAG_BIT_USED	0
+#define UC_SPRITES_FLAG_BIT_VISIBLE	1
+#define UC_SPRITES_FLAG_BIT_DRAWN	2
+#define UC_SPRITES_FLAG_BIT_CHANGED	3
+
+struct uc_sprite_struct {
+	uint8_t flags;
+	const uint8_t *progmem_bitmap;
+	const uint8_t *progmem_mask;
+	uint8_t width;
+	uint8_t height;
+	uint8_t x;					//requested position
+	uint8_t y;
+	uint8_t drawn_x;			//position the saved background belongs to
+	uint8_t drawn_y;
+	uint16_t arena_offset;
+};
+
+typedef struct uc_sprite_struct uc_sprite;
+
+uc_sprite uc_sprites[UC_SPRITES_MAX];
+uint8_t uc_sprites_arena[UC_SPRITES_ARENA_SIZE];
+uint16_t uc_sprites_arena_used = 0;
+
+/* Regions changed by the last update, at most two per sprite (old and new position) */
+uc_graphics_rect uc_sprites_dirty_rects[UC_SPRITES_MAX * 2];
+uint8_t uc_sprites_dirty_rects_count = 0;
+
+/**
+ * Removes all sprites and frees the arena. Does not touch the buffer.
+ */
+void uc_sprites_init() {
+	for ( uint8_t i = 0; i < UC_SPRITES_MAX; i++ ) {
+		uc_sprites[i].flags = 0;
+	}
+
+	uc_sprites_arena_used = 0;
+	uc_sprites_dirty_rects_count = 0;
+}
+
+/**
+ * Adds a sprite. It is hidden until uc_sprites_show() is called.
+ *
+ * params:
+ * 		- progmem_bitmap: pixels in page layout stored in progmem
+ * 		- progmem_mask: mask in page layout stored in progmem or 0 for rectangular sprites
+ * 		- width: width of sprite
+ * 		- height: height of sprite
+ *
+ * returns: handle of sprite, -1 if sprite table or arena is full.
+ */
+int8_t uc_sprites_add(const uint8_t *progmem_bitmap,
+					  const uint8_t *progmem_mask,
+					  uint8_t width,
+					  uint8_t height) {
+
+	//Worst case: sprite is not page aligned and touches one more page
+	uint16_t size = (uint16_t)width * ((height + 14)/8);
+	if ( uc_sprites_arena_used + size > UC_SPRITES_ARENA_SIZE ) return -1;
+
+	for ( uint8_t i = 0; i < UC_SPRITES_MAX; i++ ) {
+		uc_sprite *sprite = &uc_sprites[i];
+
+		if ( !(sprite->flags & (1 << UC_SPRITES_FLAG_BIT_USED)) ) {
+			sprite->flags = (1 << UC_SPRITES_FLAG_BIT_USED);
+			sprite->progmem_bitmap = progmem_bitmap;
+			sprite->progmem_mask = progmem_mask;
+			sprite->width = width;
+			sprite->height = height;
+			sprite->x = 0;
+			sprite->y = 0;
+			sprite->arena_offset = uc_sprites_arena_used;
+
+			uc_sprites_arena_used += size;
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Sets the position of a sprite. Takes effect on next update.
+ *
+ * params:
+ * 		- handle: handle of sprite, invalid handles (e.g. -1 of a failed uc_sprites_add) are ignored
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ */
+void uc_sprites_move(int8_t handle, uint8_t x, uint8_t y) {
+	if ( handle < 0 || handle >= UC_SPRITES_MAX ) return;
+
+	uc_sprite *sprite = &uc_sprites[handle];
+
+	if ( sprite->x != x || sprite->y != y ) {
+		sprite->x = x;
+		sprite->y = y;
+		sprite->flags |= (1 << UC_SPRITES_FLAG_BIT_CHANGED);
+	}
+}
+
+/**
+ * Shows a sprite. Takes effect on next update.
+ *
+ * params:
+ * 		- handle: handle of sprite, invalid handles (e.g. -1 of a failed uc_sprites_add) are ignored
+ */
+void uc_sprites_show(int8_t handle) {
+	if ( handle < 0 || handle >= UC_SPRITES_MAX ) return;
+
+	uc_sprite *sprite = &uc_sprites[handle];
+
+	if ( !(sprite->flags & (1 << UC_SPRITES_FLAG_BIT_VISIBLE)) ) {
+		sprite->flags |= (1 << UC_SPRITES_FLAG_BIT_VISIBLE) | (1 << UC_SPRITES_FLAG_BIT_CHANGED);
+	}
+}
+
+/**
+ * Hides a sprite. Takes effect on next update.
+ *
+ * params:
+ * 		- handle: handle of sprite, invalid handles (e.g. -1 of a failed uc_sprites_add) are ignored
+ */
+void uc_sprites_hide(int8_t handle) {
+	if ( handle < 0 || handle >= UC_SPRITES_MAX ) return;
+
+	uc_sprite *sprite = &uc_sprites[handle];
+
+	if ( sprite->flags & (1 << UC_SPRITES_FLAG_BIT_VISIBLE) ) {
+		sprite->flags &= ~(1 << UC_SPRITES_FLAG_BIT_VISIBLE);
+		sprite->flags |= (1 << UC_SPRITES_FLAG_BIT_CHANGED);
+	}
+}
+
+/*
+ * Adds a rectangle to the dirty rectangles, merges it with an overlapping one.
+ */
+void uc_sprites_add_dirty_rect(const uc_graphics_rect *rect) {
+	for ( uint8_t i = 0; i < uc_sprites_dirty_rects_count; i++ ) {
+		if ( uc_graphics_rects_overlap(&uc_sprites_dirty_rects[i], rect) ) {
+			uc_graphics_rect_union(&uc_sprites_dirty_rects[i], rect);
+			return;
+		}
+	}
+
+	uc_sprites_dirty_rects[uc_sprites_dirty_rects_count++] = *rect;
+}
+
+/**
+ * Applies all moves, shows and hides. Changed sprites and every sprite
+ * overlapping them get their background restored (topmost first) and are
+ * drawn again (bottom most first, later added sprites are on top).
+ * Untouched sprites stay as they are.
+ *
+ * The changed regions are stored in uc_sprites_dirty_rects.
+ */
+void uc_sprites_update() {
+	uint8_t redraw[UC_SPRITES_MAX];
+	uc_graphics_rect old_rects[UC_SPRITES_MAX];
+	uc_graphics_rect new_rects[UC_SPRITES_MAX];
+
+	uc_sprites_dirty_rects_count = 0;
+
+	for ( uint8_t i = 0; i < UC_SPRITES_MAX; i++ ) {
+		uc_sprite *sprite = &uc_sprites[i];
+
+		old_rects[i].width = 0;
+		new_rects[i].width = 0;
+
+		if ( sprite->flags & (1 << UC_SPRITES_FLAG_BIT_DRAWN) ) {
+			old_rects[i] = (uc_graphics_rect){ sprite->drawn_x, sprite->drawn_y, sprite->width, sprite->height };
+		}
+		if ( sprite->flags & (1 << UC_SPRITES_FLAG_BIT_VISIBLE) ) {
+			new_rects[i] = (uc_graphics_rect){ sprite->x, sprite->y, sprite->width, sprite->height };
+		}
+
+		redraw[i] = (sprite->flags & (1 << UC_SPRITES_FLAG_BIT_CHANGED)) ? 1 : 0;
+	}
+
+	//Sprites overlapping redrawn ones need to be redrawn too
+	uint8_t found = 1;
+	while ( found ) {
+		found = 0;
+		for ( uint8_t i = 0; i < UC_SPRITES_MAX; i++ ) {
+			if ( redraw[i] || !(uc_sprites[i].flags & (1 << UC_SPRITES_FLAG_BIT_DRAWN)) ) continue;
+
+			for ( uint8_t j = 0; j < UC_SPRITES_MAX; j++ ) {
+				if ( !redraw[j] ) continue;
+				if ( uc_graphics_rects_overlap(&old_rects[i], &old_rects[j]) ||
+					 uc_graphics_rects_overlap(&old_rects[i], &new_rects[j]) ) {
+					redraw[i] = 1;
+					found = 1;
+					break;
+				}
+			}
+		}
+	}
+
+	//Restore backgrounds, topmost sprite first
+	for ( int8_t i = UC_SPRITES_MAX - 1; i >= 0; i-- ) {
+		uc_sprite *sprite = &uc_sprites[i];
+		if ( !redraw[i] || !(sprite->flags & (1 << UC_SPRITES_FLAG_BIT_DRAWN)) ) continue;
+
+		LCD_API_RESTORE_RECT(sprite->drawn_x, sprite->drawn_y, sprite->width, sprite->height,
+							 &uc_sprites_arena[sprite->arena_offset]);
+		sprite->flags &= ~(1 << UC_SPRITES_FLAG_BIT_DRAWN);
+		uc_sprites_add_dirty_rect(&old_rects[i]);
+	}
+
+	//Save backgrounds and draw, bottom most sprite first
+	for ( uint8_t i = 0; i < UC_SPRITES_MAX; i++ ) {
+		uc_sprite *sprite = &uc_sprites[i];
+		if ( !redraw[i] ) continue;
+
+		sprite->flags &= ~(1 << UC_SPRITES_FLAG_BIT_CHANGED);
+		if ( !(sprite->flags & (1 << UC_SPRITES_FLAG_BIT_VISIBLE)) ) continue;
+
+		LCD_API_SAVE_RECT(sprite->x, sprite->y, sprite->width, sprite->height,
+						  &uc_sprites_arena[sprite->arena_offset]);
+		LCD_API_BLIT(sprite->x, sprite->y, sprite->width, sprite->height,
+					 sprite->progmem_bitmap, sprite->progmem_mask, 1);
+
+		sprite->drawn_x = sprite->x;
+		sprite->drawn_y = sprite->y;
+		sprite->flags |= (1 << UC_SPRITES_FLAG_BIT_DRAWN);
+		uc_sprites_add_dirty_rect(&new_rects[i]);
+	}
+}
+
+#endif
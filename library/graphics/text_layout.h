@@ -0,0 +1,317 @@
+/**
+ * This library lays out paragraphs of text in a box: lines are broken at
+ * word boundaries (spaces) or at '\n' and aligned left, centered or right.
+ *
+ * The line breaks are computed once by uc_text_layout_break() and stored
+ * in a table of the layout (start, length and width per line, 4 bytes).
+ * Drawing, partial redraws of single lines and scrolling use this table
+ * and do not scan the text again. Call uc_text_layout_break() again after
+ * the text has changed.
+ *
+ * Words wider than the box are broken at the last character which fits.
+ * A character wider than the box gets a line of its own and is clipped.
+ * Spaces at line breaks are not drawn.
+ *
+ * Scrolling by less than the visible lines moves the box content with a
+ * block move (uc_graphics_scroll_rect) and draws only the lines which have
+ * been scrolled in.
+ *
+ * Capacity can be changed by defining following macro before including
+ * this header file:
+ * 		- UC_TEXT_LAYOUT_MAX_LINES: lines per layout (default 16), text
+ * 		  beyond is not laid out.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_GRAPHICS_TEXT_LAYOUT_H_
+#define UC_AVR_GRAPHICS_TEXT_LAYOUT_H_
+
+#ifndef LCD_API_SET_PIXEL
+#error "µC-Graphics text layout library does require LCD_API_SET_PIXEL makro to be set, in order to draw."
+#endif
+
+#include <avr/pgmspace.h>
+#include "../graphics/graphics.h"
+#include "../graphics/fonts.h"
+
+#ifndef UC_TEXT_LAYOUT_MAX_LINES
+	//Change here or set macro before including this header file!
+	#define UC_TEXT_LAYOUT_MAX_LINES 16
+#endif
+
+#define UC_TEXT_LAYOUT_ALIGN_LEFT	0
+#define UC_TEXT_LAYOUT_ALIGN_CENTER	1
+#define UC_TEXT_LAYOUT_ALIGN_RIGHT	2
+
+struct uc_text_layout_line_struct {
+	uint16_t start;					//index of first character in text
+	uint8_t length;					//amount of characters to draw
+	uint8_t width;					//width of the characters in pixels
+};
+
+typedef struct uc_text_layout_line_struct uc_text_layout_line;
+
+struct uc_text_layout_struct {
+	const char *text;
+	uint8_t progmem;				//1 if text is stored in progmem
+	const uint8_t *progmem_font;
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;
+	uint8_t height;
+	uint8_t line_spacing;
+	uint8_t align;
+	uint8_t rows;					//visible lines
+	uint8_t top;					//line shown in first row
+	uint8_t lines_count;
+	uc_text_layout_line lines[UC_TEXT_LAYOUT_MAX_LINES];
+};
+
+typedef struct uc_text_layout_struct uc_text_layout;
+
+/*
+ * Reads a character of the text of a layout.
+ */
+uint8_t uc_text_layout_get_char(uc_text_layout *layout, uint16_t index) {
+	return layout->progmem ? pgm_read_byte(&layout->text[index]) : layout->text[index];
+}
+
+/**
+ * Computes the line break table of a layout, see file header. Has to be
+ * called after the text has been changed.
+ *
+ * params:
+ * 		- layout: layout to break into lines
+ *
+ * returns: 1 if the whole text has been laid out, 0 if it needs more than UC_TEXT_LAYOUT_MAX_LINES lines.
+ */
+uint8_t uc_text_layout_break(uc_text_layout *layout) {
+	uint16_t index = 0;
+	uint8_t current_char_code;
+	uint8_t wrapped = 0;
+
+	layout->lines_count = 0;
+
+	while ( 1 ) {
+		//Spaces at the beginning of a wrapped line are dropped
+		if ( wrapped ) {
+			while ( uc_text_layout_get_char(layout, index) == ' ' ) index++;
+		}
+
+		current_char_code = uc_text_layout_get_char(layout, index);
+		if ( current_char_code == 0 ) return 1;
+		if ( layout->lines_count == UC_TEXT_LAYOUT_MAX_LINES ) return 0;
+
+		//Length up to the next forced break
+		uint8_t paragraph_length = 0;
+		while ( paragraph_length < 255 ) {
+			current_char_code = uc_text_layout_get_char(layout, index + paragraph_length);
+			if ( current_char_code == 0 || current_char_code == '\n' ) break;
+			paragraph_length++;
+		}
+
+		uint16_t line_width;
+		uint8_t length = uc_fonts_measure_chars(&layout->text[index], layout->progmem, paragraph_length, layout->width, layout->progmem_font, &line_width);
+		uint8_t next = length;
+
+		if ( length < paragraph_length ) {
+			//Break at the last space which fits, the character after the fitting ones included
+			uint8_t space = length;
+			while ( space > 0 && uc_text_layout_get_char(layout, index + space) != ' ' ) space--;
+
+			if ( space > 0 ) {
+				next = space;
+				length = space;
+			} else if ( length == 0 ) {
+				//Character wider than the box: at least its bytes make a line
+				length = uc_fonts_measure_chars(&layout->text[index], layout->progmem, 1, 0xFFFF, layout->progmem_font, &line_width);
+				next = length;
+			}
+		}
+
+		//Trailing spaces are not part of the line
+		while ( length > 0 && uc_text_layout_get_char(layout, index + length - 1) == ' ' ) length--;
+		uc_fonts_measure_chars(&layout->text[index], layout->progmem, length, 0xFFFF, layout->progmem_font, &line_width);
+
+		uc_text_layout_line *line = &layout->lines[layout->lines_count++];
+		line->start = index;
+		line->length = length;
+		line->width = line_width;
+
+		index += next;
+		wrapped = uc_text_layout_get_char(layout, index) != '\n';
+		if ( !wrapped ) index++;
+	}
+}
+
+/**
+ * Initializes a layout and computes its line breaks. Nothing is drawn.
+ *
+ * params:
+ * 		- layout: layout to initialize
+ * 		- text: text to lay out, has to stay valid as long as the layout is used
+ * 		- progmem: 1 if text is stored in progmem
+ * 		- x: x coordinate of left column of the box
+ * 		- y: y coordinate of top row of the box
+ * 		- width: width of the box
+ * 		- height: height of the box
+ * 		- line_spacing: amount of pixels between lines
+ * 		- align: UC_TEXT_LAYOUT_ALIGN_LEFT, UC_TEXT_LAYOUT_ALIGN_CENTER or UC_TEXT_LAYOUT_ALIGN_RIGHT
+ * 		- progmem_font: font stored in progmem
+ *
+ * returns: 1 if the whole text has been laid out, 0 if it needs more than UC_TEXT_LAYOUT_MAX_LINES lines.
+ */
+uint8_t uc_text_layout_init(uc_text_layout *layout,
+							const char *text,
+							uint8_t progmem,
+							uint8_t x,
+							uint8_t y,
+							uint8_t width,
+							uint8_t height,
+							uint8_t line_spacing,
+							uint8_t align,
+							const uint8_t *progmem_font) {
+
+	uint8_t row_height = uc_fonts_get_char_height(progmem_font) + line_spacing;
+
+	layout->text = text;
+	layout->progmem = progmem;
+	layout->progmem_font = progmem_font;
+	layout->x = x;
+	layout->y = y;
+	layout->width = width;
+	layout->height = height;
+	layout->line_spacing = line_spacing;
+	layout->align = align;
+	layout->rows = (height + line_spacing) / row_height;
+	layout->top = 0;
+
+	return uc_text_layout_break(layout);
+}
+
+/**
+ * Redraws a line of a layout if it is visible. The row of the line is
+ * cleared first, so this can be used after the text of a line has changed
+ * as long as the line breaks stay the same.
+ *
+ * params:
+ * 		- layout: layout to draw
+ * 		- line: index of line in the line break table
+ */
+void uc_text_layout_draw_line(uc_text_layout *layout, uint8_t line) {
+	if ( line < layout->top || line >= layout->top + layout->rows ) return;
+
+	uint8_t font_height = uc_fonts_get_char_height(layout->progmem_font);
+	uint8_t y = layout->y + (line - layout->top) * (font_height + layout->line_spacing);
+
+	uc_graphics_fill_rect(layout->x, y, layout->width, font_height, 0);
+	if ( line >= layout->lines_count ) return;
+
+	uc_text_layout_line *entry = &layout->lines[line];
+	uint8_t x = layout->x;
+	//A line of one character wider than the box starts at its left edge
+	uint8_t space = (entry->width < layout->width) ? layout->width - entry->width : 0;
+	if ( layout->align == UC_TEXT_LAYOUT_ALIGN_CENTER ) x += space / 2;
+	if ( layout->align == UC_TEXT_LAYOUT_ALIGN_RIGHT ) x += space;
+
+	#ifdef LCD_API_INTERSECT_CLIP
+		LCD_API_CLIP previous_clip;
+		LCD_API_GET_CLIP(&previous_clip);
+		LCD_API_INTERSECT_CLIP(layout->x, y, layout->width, font_height);
+	#endif
+
+	uc_fonts_draw_chars(&layout->text[entry->start], layout->progmem, entry->length, x, y, 1, 0, 0, layout->progmem_font);
+
+	#ifdef LCD_API_INTERSECT_CLIP
+		LCD_API_RESTORE_CLIP(&previous_clip);
+	#endif
+}
+
+/**
+ * Redraws a range of lines of a layout, lines which are not visible are
+ * skipped.
+ *
+ * params:
+ * 		- layout: layout to draw
+ * 		- first_line: index of first line to redraw
+ * 		- count: amount of lines to redraw
+ */
+void uc_text_layout_draw_lines(uc_text_layout *layout, uint8_t first_line, uint8_t count) {
+	for ( uint8_t i = 0; i < count; i++ ) {
+		uc_text_layout_draw_line(layout, first_line + i);
+	}
+}
+
+/**
+ * Clears the box of a layout and draws all visible lines.
+ *
+ * params:
+ * 		- layout: layout to draw
+ */
+void uc_text_layout_draw(uc_text_layout *layout) {
+	uc_graphics_fill_rect(layout->x, layout->y, layout->width, layout->height, 0);
+	uc_text_layout_draw_lines(layout, layout->top, layout->rows);
+}
+
+/**
+ * Scrolls a layout so that a line is shown in the first row. Only lines
+ * which have been scrolled in are drawn, see file header.
+ *
+ * params:
+ * 		- layout: layout to scroll
+ * 		- top: line to show in first row, clamped so that the last row shows the last line
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_text_layout_scroll(uc_text_layout *layout, uint8_t top) {
+	uint8_t max_top = (layout->lines_count > layout->rows) ? layout->lines_count - layout->rows : 0;
+	if ( top > max_top ) top = max_top;
+	if ( top == layout->top ) return 0;
+
+	uint8_t old_top = layout->top;
+	uint8_t shift = (top > old_top) ? top - old_top : old_top - top;
+	layout->top = top;
+
+	if ( shift >= layout->rows ) {
+		uc_text_layout_draw(layout);
+		return 1;
+	}
+
+	uint8_t row_height = uc_fonts_get_char_height(layout->progmem_font) + layout->line_spacing;
+	uint16_t rows_height = layout->rows * row_height;
+	if ( rows_height > layout->height ) rows_height = layout->height;
+
+	int8_t dy = (top > old_top) ? -(int8_t)(shift * row_height) : (int8_t)(shift * row_height);
+	uc_graphics_scroll_rect(layout->x, layout->y, layout->width, rows_height, 0, dy, 0);
+
+	uint8_t first_exposed = (top > old_top) ? top + layout->rows - shift : top;
+	uc_text_layout_draw_lines(layout, first_exposed, shift);
+
+	return 1;
+}
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * This tiny library offers sine and cosine without floating point math.
+ * One call costs a table lookup in PROGMEM instead of thousands of cycles
+ * of the avr-libm functions.
+ *
+ * Angles are binary angles:
+ * 		- uint8_t angle: 256 steps per full circle (1.40625° per step).
+ * 		- uint16_t fine angle: 65536 steps per full circle, values between
+ * 		  the table entries are interpolated linearly.
+ * 		- 0 points right (3 o'clock), angles increase counter clockwise
+ * 		  (mathematical direction, 64 = 90° points up).
+ *
+ * Results are fixed point numbers:
+ * 		- Q15: -32767 ... 32767 represents -1.0 ... 1.0.
+ * 		- Q8: -256 ... 256 represents -1.0 ... 1.0, handy for pixel math as
+ * 		  (radius * sin_q8) >> 8 fits into 16 bits for radii up to 127.
+ *
+ * Only a quarter wave (65 entries, 130 bytes) is stored, the other
+ * quadrants are mirrored.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_MATH_TRIGONOMETRY_H_
+#define UC_MATH_TRIGONOMETRY_H_
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+/* round(sin(i * 90° / 64) * 32768) for i = 0 ... 64, the last entry clamped to 32767 */
+const uint16_t UC_TRIG_QUARTER_SINE_Q15[65] PROGMEM = {
+	0, 804, 1608, 2411, 3212, 4011, 4808, 5602,
+	6393, 7180, 7962, 8740, 9512, 10279, 11039, 11793,
+	12540, 13279, 14010, 14733, 15447, 16151, 16846, 17531,
+	18205, 18868, 19520, 20160, 20788, 21403, 22006, 22595,
+	23170, 23732, 24279, 24812, 25330, 25833, 26320, 26791,
+	27246, 27684, 28106, 28511, 28899, 29269, 29622, 29957,
+	30274, 30572, 30853, 31114, 31357, 31581, 31786, 31972,
+	32138, 32286, 32413, 32522, 32610, 32679, 32729, 32758,
+	32767
+};
+
+/**
+ * Calculates the sine of a binary angle.
+ *
+ * params:
+ * 		- angle: 256 steps per full circle
+ *
+ * returns: sine in Q15 (-32767 ... 32767).
+ */
+int16_t uc_trig_sin_q15(uint8_t angle) {
+	uint8_t index = angle & 0x3F;
+
+	//Second and fourth quadrant run backwards through the table
+	if ( angle & 0x40 ) index = 64 - index;
+
+	int16_t value = pgm_read_word(&UC_TRIG_QUARTER_SINE_Q15[index]);
+
+	//Lower half of circle is negative
+	return (angle & 0x80) ? -value : value;
+}
+
+/**
+ * Calculates the cosine of a binary angle.
+ *
+ * params:
+ * 		- angle: 256 steps per full circle
+ *
+ * returns: cosine in Q15 (-32767 ... 32767).
+ */
+int16_t uc_trig_cos_q15(uint8_t angle) {
+	return uc_trig_sin_q15(angle + 64);
+}
+
+/**
+ * Calculates the sine of a fine binary angle, interpolating linearly
+ * between the table entries.
+ *
+ * params:
+ * 		- angle: 65536 steps per full circle
+ *
+ * returns: sine in Q15 (-32767 ... 32767).
+ */
+int16_t uc_trig_sin_fine_q15(uint16_t angle) {
+	uint8_t step = angle >> 8;
+	uint8_t fraction = angle & 0xFF;
+
+	int16_t a = uc_trig_sin_q15(step);
+	if ( fraction == 0 ) return a;
+
+	int16_t b = uc_trig_sin_q15(step + 1);
+	return a + (int16_t)(((int32_t)(b - a) * fraction) >> 8);
+}
+
+/**
+ * Calculates the cosine of a fine binary angle, interpolating linearly
+ * between the table entries.
+ *
+ * params:
+ * 		- angle: 65536 steps per full circle
+ *
+ * returns: cosine in Q15 (-32767 ... 32767).
+ */
+int16_t uc_trig_cos_fine_q15(uint16_t angle) {
+	return uc_trig_sin_fine_q15(angle + 16384);
+}
+
+/**
+ * Calculates the sine of a binary angle.
+ *
+ * params:
+ * 		- angle: 256 steps per full circle
+ *
+ * returns: sine in Q8 (-256 ... 256).
+ */
+int16_t uc_trig_sin_q8(uint8_t angle) {
+	int16_t value = uc_trig_sin_q15(angle);
+	return (value + (value < 0 ? -64 : 64)) / 128;
+}
+
+/**
+ * Calculates the cosine of a binary angle.
+ *
+ * params:
+ * 		- angle: 256 steps per full circle
+ *
+ * returns: cosine in Q8 (-256 ... 256).
+ */
+int16_t uc_trig_cos_q8(uint8_t angle) {
+	return uc_trig_sin_q8(angle + 64);
+}
+
+/**
+ * Multiplies a value with a Q15 factor, rounding to nearest.
+ *
+ * params:
+ * 		- value: any value, e.g. a radius in pixels
+ * 		- factor_q15: factor in Q15, e.g. result of uc_trig_sin_q15
+ *
+ * returns: value * factor.
+ */
+int16_t uc_trig_mul_q15(int16_t value, int16_t factor_q15) {
+	int32_t product = (int32_t)value * factor_q15;
+	return (product + (product < 0 ? -16384 : 16384)) / 32768;
+}
+
+/**
+ * Converts degrees into a fine binary angle.
+ *
+ * params:
+ * 		- degrees: angle in degrees, negative values and values above 360 are wrapped
+ *
+ * returns: fine binary angle (65536 steps per full circle).
+ */
+uint16_t uc_trig_degrees_to_fine_angle(int16_t degrees) {
+	int32_t wrapped = degrees % 360;
+	if ( wrapped < 0 ) wrapped += 360;
+
+	return (uint16_t)((wrapped * 65536L + 180) / 360);
+}
+
+#endif
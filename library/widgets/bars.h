@@ -0,0 +1,229 @@
+/**
+ * This library draws level bars (bar graphs) and progress bars which are
+ * updated incrementally.
+ *
+ * A bar remembers the extent (filled pixels) it has drawn last. On update
+ * only the difference between the old and the new extent is filled or
+ * cleared, byte wise through uc_graphics_fill_rect. Moving a 100 pixel
+ * bar by 3 % touches 3 columns, nothing is drawn if the extent stays the
+ * same. The changed region is reported as dirty rectangle, e.g. to send
+ * only that region to a second display.
+ *
+ * Directions:
+ * 		- UC_BAR_DIRECTION_RIGHT: grows from left to right.
+ * 		- UC_BAR_DIRECTION_UP: grows from bottom to top.
+ *
+ * Progress bars are horizontal bars with frame whose value is a count of
+ * done steps out of a total of up to 65535 steps.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_WIDGETS_BARS_H_
+#define UC_AVR_WIDGETS_BARS_H_
+
+#ifndef LCD_API_SET_PIXEL
+#error "µC-Graphics bars library does require LCD_API_SET_PIXEL makro to be set, in order to draw."
+#endif
+
+#include "../graphics/graphics.h"
+
+#define UC_BAR_DIRECTION_RIGHT	0
+#define UC_BAR_DIRECTION_UP		1
+
+struct uc_bar_struct {
+	uint8_t x;					//fill area (inside frame)
+	uint8_t y;
+	uint8_t width;
+	uint8_t height;
+	uint8_t direction;
+	uint8_t extent;				//filled pixels drawn last
+	int16_t min;
+	int16_t max;
+};
+
+typedef struct uc_bar_struct uc_bar;
+
+struct uc_progress_struct {
+	uc_bar bar;
+	uint16_t total;
+};
+
+typedef struct uc_progress_struct uc_progress;
+
+/*
+ * Retrieves the length of the fill area in growing direction.
+ */
+uint8_t uc_bar_get_length(uc_bar *bar) {
+	return (bar->direction == UC_BAR_DIRECTION_UP) ? bar->height : bar->width;
+}
+
+/*
+ * Maps a part out of a whole to an extent in pixels.
+ */
+uint8_t uc_bar_get_extent(uc_bar *bar, uint32_t part, uint32_t whole) {
+	if ( whole == 0 ) return 0;
+	if ( part >= whole ) return uc_bar_get_length(bar);
+
+	return (uint8_t)((part * uc_bar_get_length(bar)) / whole);
+}
+
+/**
+ * Sets the extent of a bar directly. Only the pixels between the old and
+ * the new extent are drawn.
+ *
+ * params:
+ * 		- bar: bar to update
+ * 		- extent: filled pixels, clamped to the length of the bar
+ * 		- dirty: receives the changed region (width 0 if nothing changed), may be 0
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_bar_set_extent(uc_bar *bar, uint8_t extent, uc_graphics_rect *dirty) {
+	uint8_t length = uc_bar_get_length(bar);
+	if ( extent > length ) extent = length;
+
+	if ( dirty ) dirty->width = 0;
+	if ( extent == bar->extent ) return 0;
+
+	uint8_t low = (extent < bar->extent) ? extent : bar->extent;
+	uint8_t delta = (extent < bar->extent) ? (bar->extent - extent) : (extent - bar->extent);
+	uint8_t pixel = (extent > bar->extent) ? 1 : 0;
+
+	uc_graphics_rect changed;
+	if ( bar->direction == UC_BAR_DIRECTION_UP ) {
+		changed.x = bar->x;
+		changed.y = bar->y + bar->height - low - delta;
+		changed.width = bar->width;
+		changed.height = delta;
+	} else {
+		changed.x = bar->x + low;
+		changed.y = bar->y;
+		changed.width = delta;
+		changed.height = bar->height;
+	}
+
+	uc_graphics_fill_rect(changed.x, changed.y, changed.width, changed.height, pixel);
+	bar->extent = extent;
+
+	if ( dirty ) *dirty = changed;
+	return 1;
+}
+
+/**
+ * Initializes a bar and draws it empty.
+ *
+ * params:
+ * 		- bar: bar to initialize
+ * 		- x: x coordinate of left column (of frame, if any)
+ * 		- y: y coordinate of top row (of frame, if any)
+ * 		- width: width of bar including frame
+ * 		- height: height of bar including frame
+ * 		- direction: UC_BAR_DIRECTION_RIGHT or UC_BAR_DIRECTION_UP
+ * 		- min: value of empty bar
+ * 		- max: value of full bar (> min)
+ * 		- frame: 1 to draw a frame with one pixel gap around the fill area
+ */
+void uc_bar_init(uc_bar *bar,
+				 uint8_t x,
+				 uint8_t y,
+				 uint8_t width,
+				 uint8_t height,
+				 uint8_t direction,
+				 int16_t min,
+				 int16_t max,
+				 uint8_t frame) {
+
+	if ( frame ) {
+		uc_graphics_draw_rect(x, y, width, height, 1);
+		x += 2;
+		y += 2;
+		width -= 4;
+		height -= 4;
+	}
+
+	bar->x = x;
+	bar->y = y;
+	bar->width = width;
+	bar->height = height;
+	bar->direction = direction;
+	bar->extent = 0;
+	bar->min = min;
+	bar->max = max;
+
+	uc_graphics_fill_rect(x, y, width, height, 0);
+}
+
+/**
+ * Shows a new value. Only the difference to the value drawn last is drawn.
+ *
+ * params:
+ * 		- bar: bar to update
+ * 		- value: new value, clamped to min and max
+ * 		- dirty: receives the changed region (width 0 if nothing changed), may be 0
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_bar_set_value(uc_bar *bar, int16_t value, uc_graphics_rect *dirty) {
+	if ( value < bar->min ) value = bar->min;
+
+	uint8_t extent = uc_bar_get_extent(bar, (int32_t)value - bar->min, (int32_t)bar->max - bar->min);
+	return uc_bar_set_extent(bar, extent, dirty);
+}
+
+/**
+ * Initializes a progress bar (horizontal, with frame) and draws it empty.
+ *
+ * params:
+ * 		- progress: progress bar to initialize
+ * 		- x: x coordinate of left column of frame
+ * 		- y: y coordinate of top row of frame
+ * 		- width: width including frame
+ * 		- height: height including frame
+ * 		- total: amount of steps of complete progress
+ */
+void uc_progress_init(uc_progress *progress, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint16_t total) {
+	uc_bar_init(&progress->bar, x, y, width, height, UC_BAR_DIRECTION_RIGHT, 0, 0, 1);
+	progress->total = total;
+}
+
+/**
+ * Shows the amount of done steps. Only the difference to the progress
+ * drawn last is drawn, so calling it for every step is cheap.
+ *
+ * params:
+ * 		- progress: progress bar to update
+ * 		- done: amount of done steps
+ * 		- dirty: receives the changed region (width 0 if nothing changed), may be 0
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_progress_set(uc_progress *progress, uint16_t done, uc_graphics_rect *dirty) {
+	uint8_t extent = uc_bar_get_extent(&progress->bar, done, progress->total);
+	return uc_bar_set_extent(&progress->bar, extent, dirty);
+}
+
+#endif
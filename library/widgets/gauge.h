@@ -0,0 +1,218 @@
+/**
+ * This library draws an analog gauge: a needle rotating around a hub
+ * over a dial, e.g. for speed, temperature or battery level.
+ *
+ * Needle end points are calculated with the fixed point tables of the
+ * trigonometry library, no floating point math is needed. Changing the
+ * value does not redraw the dial: only the old needle is erased and the
+ * new one is drawn, and nothing happens at all if the needle end point
+ * does not move.
+ *
+ * Erase modes:
+ * 		- XOR (needs LCD_API_SET_RASTER_OP): the needle is drawn with the
+ * 		  XOR raster operation, so drawing it a second time restores the
+ * 		  dial exactly, ticks and labels under the needle included. The
+ * 		  needle appears inverted where it crosses black pixels.
+ * 		- Plain: the old needle is drawn white, then the new one black and
+ * 		  the hub is redrawn. Dial pixels under the old needle are lost,
+ * 		  so keep ticks and labels outside the needle radius.
+ *
+ * Angles are given in degrees, 0 points right and angles increase
+ * counter clockwise. The scale runs clockwise from start_degrees, e.g.
+ * start 225 and sweep 270 is the classic speedometer with the minimum
+ * at the bottom left and the maximum at the bottom right.
+ *
+ * Usage:
+ * 		- Draw the dial (uc_gauge_draw_ticks() helps).
+ * 		- Call uc_gauge_init() once.
+ * 		- Call uc_gauge_set_value() per new value.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_WIDGETS_GAUGE_H_
+#define UC_AVR_WIDGETS_GAUGE_H_
+
+#ifndef LCD_API_SET_PIXEL
+#error "µC-Graphics gauge library does require LCD_API_SET_PIXEL makro to be set, in order to draw."
+#endif
+
+#include "../graphics/graphics.h"
+#include "../math/trigonometry.h"
+
+#define UC_GAUGE_FLAG_BIT_XOR		0
+#define UC_GAUGE_FLAG_BIT_DRAWN		1
+
+struct uc_gauge_struct {
+	uint8_t flags;
+	uint8_t center_x;			//hub
+	uint8_t center_y;
+	uint8_t radius;				//needle length
+	uint8_t hub_radius;
+	uint16_t start_angle;		//fine angle of minimum
+	uint16_t sweep;				//fine angle span, clockwise
+	int16_t min;
+	int16_t max;
+	uint8_t needle_x;			//end point of drawn needle
+	uint8_t needle_y;
+};
+
+typedef struct uc_gauge_struct uc_gauge;
+
+/*
+ * Maps a value to the fine angle of the needle.
+ */
+uint16_t uc_gauge_get_angle(uc_gauge *gauge, int16_t value) {
+	if ( value <= gauge->min ) return gauge->start_angle;
+	if ( value >= gauge->max ) return gauge->start_angle - gauge->sweep;
+
+	uint32_t offset = ((uint32_t)((int32_t)value - gauge->min) * gauge->sweep) / ((int32_t)gauge->max - gauge->min);
+	return gauge->start_angle - (uint16_t)offset;
+}
+
+/*
+ * Calculates the point at a distance from the hub in direction of a fine angle.
+ */
+void uc_gauge_get_point(uc_gauge *gauge, uint16_t angle, uint8_t distance, uint8_t *x, uint8_t *y) {
+	*x = gauge->center_x + uc_trig_mul_q15(distance, uc_trig_cos_fine_q15(angle));
+	*y = gauge->center_y - uc_trig_mul_q15(distance, uc_trig_sin_fine_q15(angle));
+}
+
+/*
+ * Draws the needle to its stored end point.
+ */
+void uc_gauge_draw_needle(uc_gauge *gauge, uint8_t pixel) {
+	uc_graphics_draw_line(gauge->center_x, gauge->center_y, gauge->needle_x, gauge->needle_y, pixel);
+}
+
+/**
+ * Draws tick marks along the scale, e.g. as part of the dial. Should be
+ * called before the needle is drawn.
+ *
+ * params:
+ * 		- gauge: initialized gauge
+ * 		- count: amount of ticks (at least 2, first at minimum, last at maximum)
+ * 		- inner_radius: distance of inner end of ticks from hub
+ * 		- outer_radius: distance of outer end of ticks from hub
+ */
+void uc_gauge_draw_ticks(uc_gauge *gauge, uint8_t count, uint8_t inner_radius, uint8_t outer_radius) {
+	for ( uint8_t i = 0; i < count; i++ ) {
+		uint16_t angle = gauge->start_angle - (uint16_t)(((uint32_t)gauge->sweep * i) / (count - 1));
+		uint8_t x1, y1, x2, y2;
+
+		uc_gauge_get_point(gauge, angle, inner_radius, &x1, &y1);
+		uc_gauge_get_point(gauge, angle, outer_radius, &x2, &y2);
+		uc_graphics_draw_line(x1, y1, x2, y2, 1);
+	}
+}
+
+/**
+ * Initializes a gauge. Draws the hub, but not the needle: it appears
+ * with the first call of uc_gauge_set_value(). The whole circle of
+ * radius around the hub must be on the display.
+ *
+ * params:
+ * 		- gauge: gauge to initialize
+ * 		- center_x: x coordinate of hub
+ * 		- center_y: y coordinate of hub
+ * 		- radius: length of needle
+ * 		- hub_radius: radius of filled hub circle, 0 for no hub
+ * 		- start_degrees: direction of needle at minimum
+ * 		- sweep_degrees: clockwise span of scale (1 ... 360)
+ * 		- min: value at start of scale
+ * 		- max: value at end of scale (> min)
+ * 		- xor_mode: 1 to erase the needle with XOR, see file header
+ */
+void uc_gauge_init(uc_gauge *gauge,
+				   uint8_t center_x,
+				   uint8_t center_y,
+				   uint8_t radius,
+				   uint8_t hub_radius,
+				   int16_t start_degrees,
+				   int16_t sweep_degrees,
+				   int16_t min,
+				   int16_t max,
+				   uint8_t xor_mode) {
+
+	gauge->flags = 0;
+	gauge->center_x = center_x;
+	gauge->center_y = center_y;
+	gauge->radius = radius;
+	gauge->hub_radius = hub_radius;
+	gauge->start_angle = uc_trig_degrees_to_fine_angle(start_degrees);
+	gauge->sweep = (sweep_degrees >= 360) ? 65535 : uc_trig_degrees_to_fine_angle(sweep_degrees);
+	gauge->min = min;
+	gauge->max = max;
+
+	#ifdef LCD_API_SET_RASTER_OP
+		if ( xor_mode ) gauge->flags |= (1 << UC_GAUGE_FLAG_BIT_XOR);
+	#endif
+
+	if ( hub_radius ) uc_graphics_fill_circle(center_x, center_y, hub_radius, 1);
+}
+
+/**
+ * Shows a new value. Only the old needle is erased and the new one is
+ * drawn, nothing is drawn if the needle end point stays the same.
+ *
+ * params:
+ * 		- gauge: gauge to update
+ * 		- value: new value, clamped to the scale
+ */
+void uc_gauge_set_value(uc_gauge *gauge, int16_t value) {
+	uint8_t x, y;
+	uc_gauge_get_point(gauge, uc_gauge_get_angle(gauge, value), gauge->radius, &x, &y);
+
+	uint8_t drawn = gauge->flags & (1 << UC_GAUGE_FLAG_BIT_DRAWN);
+	if ( drawn && x == gauge->needle_x && y == gauge->needle_y ) return;
+
+	#ifdef LCD_API_SET_RASTER_OP
+	if ( gauge->flags & (1 << UC_GAUGE_FLAG_BIT_XOR) ) {
+		uint8_t previous_op = LCD_API_GET_RASTER_OP();
+		LCD_API_SET_RASTER_OP(LCD_RASTER_OP_XOR);
+
+		//Needles share the hub pixels, XOR twice restores them
+		if ( drawn ) uc_gauge_draw_needle(gauge, 1);
+		gauge->needle_x = x;
+		gauge->needle_y = y;
+		uc_gauge_draw_needle(gauge, 1);
+
+		LCD_API_SET_RASTER_OP(previous_op);
+		gauge->flags |= (1 << UC_GAUGE_FLAG_BIT_DRAWN);
+		return;
+	}
+	#endif
+
+	if ( drawn ) uc_gauge_draw_needle(gauge, 0);
+	gauge->needle_x = x;
+	gauge->needle_y = y;
+	uc_gauge_draw_needle(gauge, 1);
+	if ( gauge->hub_radius ) uc_graphics_fill_circle(gauge->center_x, gauge->center_y, gauge->hub_radius, 1);
+
+	gauge->flags |= (1 << UC_GAUGE_FLAG_BIT_DRAWN);
+}
+
+#endif
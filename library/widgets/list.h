@@ -0,0 +1,356 @@
+/**
+ * This library draws scrollable lists, e.g. menus with many entries of
+ * which only a few fit onto the display.
+ *
+ * A list shows a window of rows and highlights the selected entry by
+ * inverting its row. Updates are incremental:
+ * 		- Moving the selection within the window inverts the old and the
+ * 		  new row, nothing else is drawn (XOR raster operation, so the text
+ * 		  is not drawn again).
+ * 		- Moving the selection out of the window scrolls the rows with a
+ * 		  block move (uc_graphics_scroll_rect) and draws only the entries
+ * 		  which have been scrolled in.
+ * 		- Jumps of a whole window or more redraw the window.
+ *
+ * Entries either come from a table of strings in progmem or from a
+ * callback which writes the text of an entry into a buffer, e.g. for
+ * entries showing values or entries read from an eeprom.
+ *
+ * Without LCD_API_SET_RASTER_OP the selected row is framed instead of
+ * inverted and rows are redrawn for every selection change.
+ *
+ * Capacity can be changed by defining following macro before including
+ * this header file:
+ * 		- UC_LIST_MAX_TEXT_LENGTH: buffer size for callback entries including
+ * 		  terminating zero (default 22).
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_WIDGETS_LIST_H_
+#define UC_AVR_WIDGETS_LIST_H_
+
+#ifndef LCD_API_SET_PIXEL
+#error "µC-Graphics list library does require LCD_API_SET_PIXEL makro to be set, in order to draw."
+#endif
+
+#include <avr/pgmspace.h>
+#include "../graphics/graphics.h"
+#include "../graphics/fonts.h"
+
+#ifndef UC_LIST_MAX_TEXT_LENGTH
+	//Change here or set macro before including this header file!
+	#define UC_LIST_MAX_TEXT_LENGTH 22
+#endif
+
+/*
+ * Writes the text of an entry as zero terminated string into buffer
+ * (UC_LIST_MAX_TEXT_LENGTH bytes).
+ */
+typedef void (*uc_list_get_entry)(uint8_t index, char *buffer, void *context);
+
+struct uc_list_struct {
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;
+	uint8_t row_height;
+	uint8_t rows;					//visible rows
+	uint8_t count;					//amount of entries
+	uint8_t top;					//entry shown in first row
+	uint8_t selected;
+	const uint8_t *progmem_font;
+	const char * const *progmem_entries;	//table of progmem strings, or 0 if get_entry is used
+	uc_list_get_entry get_entry;
+	void *context;
+};
+
+typedef struct uc_list_struct uc_list;
+
+void uc_list_draw_row(uc_list *list, uint8_t row);
+
+/*
+ * Toggles the highlight of a visible row. Without raster operations the
+ * row is redrawn instead.
+ */
+void uc_list_highlight_row(uc_list *list, uint8_t row) {
+	#ifdef LCD_API_SET_RASTER_OP
+		uc_graphics_invert_rect(list->x, list->y + row * list->row_height, list->width, list->row_height);
+	#else
+		uc_list_draw_row(list, row);
+	#endif
+}
+
+/*
+ * Clears a visible row and draws its entry, highlighted if selected.
+ */
+void uc_list_draw_row(uc_list *list, uint8_t row) {
+	uint8_t index = list->top + row;
+	uint8_t y = list->y + row * list->row_height;
+
+	uc_graphics_fill_rect(list->x, y, list->width, list->row_height, 0);
+	if ( index >= list->count ) return;
+
+	//Long entries are cut at the right edge of the list
+	#ifdef LCD_API_INTERSECT_CLIP
+		LCD_API_CLIP previous_clip;
+		LCD_API_GET_CLIP(&previous_clip);
+		LCD_API_INTERSECT_CLIP(list->x, y, list->width, list->row_height);
+	#endif
+
+	if ( list->progmem_entries ) {
+		const char *progmem_string = (const char*)pgm_read_ptr(&list->progmem_entries[index]);
+		uc_fonts_draw_string_progmem(progmem_string, list->x + 1, y, 0, 0, list->progmem_font);
+	} else {
+		char text[UC_LIST_MAX_TEXT_LENGTH];
+		text[0] = 0;
+		list->get_entry(index, text, list->context);
+		text[UC_LIST_MAX_TEXT_LENGTH - 1] = 0;
+		uc_fonts_draw_string(text, list->x + 1, y, 0, 0, list->progmem_font);
+	}
+
+	#ifdef LCD_API_INTERSECT_CLIP
+		LCD_API_RESTORE_CLIP(&previous_clip);
+	#endif
+
+	if ( index == list->selected ) {
+		#ifdef LCD_API_SET_RASTER_OP
+			uc_list_highlight_row(list, row);
+		#else
+			uc_graphics_draw_rect(list->x, y, list->width, list->row_height, 1);
+		#endif
+	}
+}
+
+/**
+ * Draws all visible rows of a list.
+ *
+ * params:
+ * 		- list: list to draw
+ */
+void uc_list_draw(uc_list *list) {
+	for ( uint8_t row = 0; row < list->rows; row++ ) {
+		uc_list_draw_row(list, row);
+	}
+}
+
+/*
+ * Sets up the fields both kinds of lists have in common.
+ */
+void uc_list_init(uc_list *list,
+				  uint8_t x,
+				  uint8_t y,
+				  uint8_t width,
+				  uint8_t height,
+				  uint8_t count,
+				  const uint8_t *progmem_font) {
+
+	list->x = x;
+	list->y = y;
+	list->width = width;
+	list->row_height = uc_fonts_get_char_height(progmem_font) + 1;
+	list->rows = height / list->row_height;
+	list->count = count;
+	list->top = 0;
+	list->selected = 0;
+	list->progmem_font = progmem_font;
+}
+
+/**
+ * Initializes a list of progmem strings with the first entry selected
+ * without drawing it, e.g. if it is drawn later with uc_list_draw().
+ *
+ * params:
+ * 		- list: list to initialize
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of list
+ * 		- height: height of list, rows are one pixel higher than the font
+ * 		- progmem_entries: table of pointers to strings, table and strings stored in progmem
+ * 		- count: amount of entries
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_list_setup_progmem(uc_list *list,
+						   uint8_t x,
+						   uint8_t y,
+						   uint8_t width,
+						   uint8_t height,
+						   const char * const *progmem_entries,
+						   uint8_t count,
+						   const uint8_t *progmem_font) {
+
+	list->progmem_entries = progmem_entries;
+	list->get_entry = 0;
+	list->context = 0;
+	uc_list_init(list, x, y, width, height, count, progmem_font);
+}
+
+/**
+ * Initializes a list of progmem strings and draws it with the first entry
+ * selected.
+ *
+ * params:
+ * 		- list: list to initialize
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of list
+ * 		- height: height of list, rows are one pixel higher than the font
+ * 		- progmem_entries: table of pointers to strings, table and strings stored in progmem
+ * 		- count: amount of entries
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_list_init_progmem(uc_list *list,
+						  uint8_t x,
+						  uint8_t y,
+						  uint8_t width,
+						  uint8_t height,
+						  const char * const *progmem_entries,
+						  uint8_t count,
+						  const uint8_t *progmem_font) {
+
+	uc_list_setup_progmem(list, x, y, width, height, progmem_entries, count, progmem_font);
+	uc_list_draw(list);
+}
+
+/**
+ * Initializes a list whose entries are provided by a callback and draws
+ * it with the first entry selected. The callback is only called for rows
+ * which are drawn.
+ *
+ * params:
+ * 		- list: list to initialize
+ * 		- x: x coordinate of left column
+ * 		- y: y coordinate of top row
+ * 		- width: width of list
+ * 		- height: height of list, rows are one pixel higher than the font
+ * 		- get_entry: writes the text of an entry into a buffer
+ * 		- context: passed to get_entry
+ * 		- count: amount of entries
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_list_init_callback(uc_list *list,
+						   uint8_t x,
+						   uint8_t y,
+						   uint8_t width,
+						   uint8_t height,
+						   uc_list_get_entry get_entry,
+						   void *context,
+						   uint8_t count,
+						   const uint8_t *progmem_font) {
+
+	list->progmem_entries = 0;
+	list->get_entry = get_entry;
+	list->context = context;
+	uc_list_init(list, x, y, width, height, count, progmem_font);
+	uc_list_draw(list);
+}
+
+/**
+ * Redraws the row of an entry if it is visible, e.g. after the value an
+ * entry shows has changed.
+ *
+ * params:
+ * 		- list: list to update
+ * 		- index: entry to redraw
+ */
+void uc_list_redraw_entry(uc_list *list, uint8_t index) {
+	if ( index < list->top || index >= list->top + list->rows ) return;
+
+	uc_list_draw_row(list, index - list->top);
+}
+
+/**
+ * Selects an entry and scrolls it into view. Only the changed rows are
+ * drawn, see file header.
+ *
+ * params:
+ * 		- list: list to update
+ * 		- index: entry to select, clamped to the last entry
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_list_select(uc_list *list, uint8_t index) {
+	if ( list->count == 0 || list->rows == 0 ) return 0;
+	if ( index >= list->count ) index = list->count - 1;
+	if ( index == list->selected ) return 0;
+
+	uint8_t old_selected = list->selected;
+	uint8_t old_top = list->top;
+	uint8_t top = old_top;
+
+	if ( index < top ) top = index;
+	if ( index >= top + list->rows ) top = index - list->rows + 1;
+
+	//Remove old highlight while the old row is still in place
+	uint8_t old_visible = old_selected >= old_top && old_selected < old_top + list->rows;
+	if ( old_visible ) {
+		list->selected = index;
+		uc_list_highlight_row(list, old_selected - old_top);
+	}
+	list->selected = index;
+
+	if ( top == old_top ) {
+		uc_list_highlight_row(list, index - top);
+		return 1;
+	}
+
+	list->top = top;
+	uint8_t shift = (top > old_top) ? top - old_top : old_top - top;
+
+	if ( shift >= list->rows ) {
+		uc_list_draw(list);
+		return 1;
+	}
+
+	//Move the remaining rows and draw the exposed ones
+	int8_t dy = (top > old_top) ? -(int8_t)(shift * list->row_height) : (int8_t)(shift * list->row_height);
+	uc_graphics_scroll_rect(list->x, list->y, list->width, list->rows * list->row_height, 0, dy, 0);
+
+	uint8_t first_exposed = (top > old_top) ? list->rows - shift : 0;
+	for ( uint8_t row = first_exposed; row < first_exposed + shift; row++ ) {
+		uc_list_draw_row(list, row);
+	}
+
+	return 1;
+}
+
+/**
+ * Moves the selection by some entries, e.g. per step of a rotary encoder.
+ *
+ * params:
+ * 		- list: list to update
+ * 		- steps: entries to move (negative: upwards), clamped to first and last entry
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_list_move(uc_list *list, int16_t steps) {
+	int16_t index = (int16_t)list->selected + steps;
+	if ( index < 0 ) index = 0;
+	if ( index > 255 ) index = 255;
+
+	return uc_list_select(list, index);
+}
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * This library draws a rolling strip chart (oscilloscope like) of samples,
+ * e.g. sensor data over time.
+ *
+ * The samples are kept in a ring buffer of one sample per column. Adding a
+ * sample does not redraw the chart: the plot area is scrolled one column to
+ * the left within the buffer (byte wise, see uc_graphics_scroll_rect) and
+ * only the newest column with the segment connecting it to the previous
+ * sample is drawn.
+ *
+ * The vertical scale adapts automatically:
+ * 		- A sample outside the scale extends it by a quarter of its span
+ * 		  in that direction, so a slowly rising signal does not cause a
+ * 		  rescale for every sample.
+ * 		- Once per full chart width of samples the range of the buffered
+ * 		  samples is checked. Only if it covers less than half of the
+ * 		  scale, the scale shrinks to the samples plus margin.
+ * 		- Only a rescale redraws the whole chart.
+ *
+ * Usage:
+ * 		- Provide a sample buffer of width elements.
+ * 		- Call uc_strip_chart_init() once.
+ * 		- Call uc_strip_chart_add_sample() per new sample.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_WIDGETS_STRIP_CHART_H_
+#define UC_AVR_WIDGETS_STRIP_CHART_H_
+
+#ifndef LCD_API_SET_PIXEL
+#error "µC-Graphics strip chart library does require LCD_API_SET_PIXEL makro to be set, in order to draw."
+#endif
+
+#include "../graphics/graphics.h"
+
+struct uc_strip_chart_struct {
+	uint8_t x;					//plot area
+	uint8_t y;
+	uint8_t width;
+	uint8_t height;
+	int16_t *samples;			//ring buffer of width samples
+	uint8_t head;				//index of next sample to write
+	uint8_t count;				//amount of valid samples
+	uint8_t samples_since_check;
+	int16_t min;				//current scale
+	int16_t max;
+	uint8_t last_row;			//y coordinate of newest plotted sample
+};
+
+typedef struct uc_strip_chart_struct uc_strip_chart;
+
+/*
+ * Maps a sample to the y coordinate within the plot area.
+ */
+uint8_t uc_strip_chart_get_row(uc_strip_chart *chart, int16_t value) {
+	if ( value <= chart->min ) return chart->y + chart->height - 1;
+	if ( value >= chart->max ) return chart->y;
+
+	int32_t offset = (((int32_t)value - chart->min) * (chart->height - 1)) / ((int32_t)chart->max - chart->min);
+	return chart->y + chart->height - 1 - offset;
+}
+
+/*
+ * Draws the connection of a column: the pixel of the sample and a vertical
+ * line towards the previous sample, so the curve has no gaps.
+ */
+void uc_strip_chart_draw_column(uint8_t column, uint8_t previous_row, uint8_t row) {
+	if ( row < previous_row ) {
+		uc_graphics_fill_rect(column, row, 1, (previous_row - row) > 1 ? (previous_row - row) : 1, 1);
+	} else if ( row > previous_row ) {
+		uint8_t start = (row - previous_row) > 1 ? previous_row + 1 : row;
+		uc_graphics_fill_rect(column, start, 1, row - start + 1, 1);
+	} else {
+		uc_graphics_fill_rect(column, row, 1, 1, 1);
+	}
+}
+
+/**
+ * Redraws the whole chart from the buffered samples.
+ *
+ * params:
+ * 		- chart: chart to draw
+ */
+void uc_strip_chart_redraw(uc_strip_chart *chart) {
+	uc_graphics_fill_rect(chart->x, chart->y, chart->width, chart->height, 0);
+	if ( chart->count == 0 ) return;
+
+	//Oldest sample is drawn at column width-count
+	uint8_t index = (chart->head + chart->width - chart->count) % chart->width;
+	uint8_t column = chart->x + chart->width - chart->count;
+	uint8_t previous_row = uc_strip_chart_get_row(chart, chart->samples[index]);
+
+	for ( uint8_t i = 0; i < chart->count; i++ ) {
+		uint8_t row = uc_strip_chart_get_row(chart, chart->samples[index]);
+		uc_strip_chart_draw_column(column, previous_row, row);
+
+		previous_row = row;
+		column++;
+		index++;
+		if ( index == chart->width ) index = 0;
+	}
+
+	chart->last_row = previous_row;
+}
+
+/**
+ * Initializes a strip chart and clears its plot area.
+ *
+ * params:
+ * 		- chart: chart to initialize
+ * 		- x: x coordinate of left column of plot area
+ * 		- y: y coordinate of top row of plot area
+ * 		- width: width of plot area (amount of visible samples)
+ * 		- height: height of plot area
+ * 		- sample_buffer: memory for width samples
+ * 		- min: initial lower end of scale
+ * 		- max: initial upper end of scale (> min)
+ */
+void uc_strip_chart_init(uc_strip_chart *chart,
+						 uint8_t x,
+						 uint8_t y,
+						 uint8_t width,
+						 uint8_t height,
+						 int16_t *sample_buffer,
+						 int16_t min,
+						 int16_t max) {
+
+	chart->x = x;
+	chart->y = y;
+	chart->width = width;
+	chart->height = height;
+	chart->samples = sample_buffer;
+	chart->head = 0;
+	chart->count = 0;
+	chart->samples_since_check = 0;
+	chart->min = min;
+	chart->max = max;
+
+	uc_strip_chart_redraw(chart);
+}
+
+/*
+ * Checks if the scale has to change for a new sample or because the
+ * buffered samples cover only a small part of it.
+ *
+ * returns: 1 if the scale changed.
+ */
+uint8_t uc_strip_chart_update_scale(uc_strip_chart *chart, int16_t value) {
+	int32_t span = (int32_t)chart->max - chart->min;
+	int32_t margin = span/4 > 0 ? span/4 : 1;
+
+	if ( value > chart->max ) {
+		int32_t max = (int32_t)value + margin;
+		chart->max = max > INT16_MAX ? INT16_MAX : max;
+		return 1;
+	}
+	if ( value < chart->min ) {
+		int32_t min = (int32_t)value - margin;
+		chart->min = min < INT16_MIN ? INT16_MIN : min;
+		return 1;
+	}
+
+	if ( ++chart->samples_since_check < chart->width ) return 0;
+	chart->samples_since_check = 0;
+
+	int16_t data_min = value;
+	int16_t data_max = value;
+	for ( uint8_t i = 0; i < chart->count; i++ ) {
+		if ( chart->samples[i] < data_min ) data_min = chart->samples[i];
+		if ( chart->samples[i] > data_max ) data_max = chart->samples[i];
+	}
+
+	int32_t data_span = (int32_t)data_max - data_min;
+	if ( data_span*2 >= span ) return 0;
+
+	margin = data_span/4 > 0 ? data_span/4 : 1;
+	int32_t min = (int32_t)data_min - margin;
+	int32_t max = (int32_t)data_max + margin;
+	chart->min = min < INT16_MIN ? INT16_MIN : min;
+	chart->max = max > INT16_MAX ? INT16_MAX : max;
+	return 1;
+}
+
+/**
+ * Adds a sample. Scrolls the chart one column to the left and draws only
+ * the new column, unless the scale has to change (full redraw).
+ *
+ * params:
+ * 		- chart: chart to add sample to
+ * 		- value: new sample
+ */
+void uc_strip_chart_add_sample(uc_strip_chart *chart, int16_t value) {
+	uint8_t rescale = uc_strip_chart_update_scale(chart, value);
+
+	chart->samples[chart->head] = value;
+	chart->head++;
+	if ( chart->head == chart->width ) chart->head = 0;
+	if ( chart->count < chart->width ) chart->count++;
+
+	if ( rescale ) {
+		uc_strip_chart_redraw(chart);
+		return;
+	}
+
+	uint8_t row = uc_strip_chart_get_row(chart, value);
+	uint8_t previous_row = (chart->count > 1) ? chart->last_row : row;
+
+	uc_graphics_scroll_rect(chart->x, chart->y, chart->width, chart->height, -1, 0, 0);
+	uc_strip_chart_draw_column(chart->x + chart->width - 1, previous_row, row);
+
+	chart->last_row = row;
+}
+
+#endif
@@ -0,0 +1,569 @@
+/**
+ * This library is a small retained mode widget toolkit. Instead of
+ * redrawing whole screens, the widgets of a screen are kept in a static
+ * array and only widgets whose content changed are redrawn.
+ *
+ * Widgets:
+ * 		- panel: container, clears its bounds, optional frame
+ * 		- label: text in RAM
+ * 		- number: signed value, right aligned (numbers library field)
+ * 		- icon: image of the images library stored in progmem
+ * 		- list: menu of progmem strings with highlighted selection (list library)
+ * 		- bar: horizontal level bar with frame (bars library)
+ * 		- checkbox: box with optional label
+ *
+ * The array is the widget tree: every widget names the index of its parent
+ * (or -1) and parents must come before their children, which is also the
+ * paint order. Changing a widget through the setters marks it invalid, a
+ * setter which does not change anything does not. uc_toolkit_render()
+ * redraws the invalid widgets (and all children of redrawn containers),
+ * clipped to their bounds, and records the regions it drew in
+ * screen->dirty_rects. In buffered mode the LCD tracks the changed bytes
+ * itself, so the following flush only sends these regions.
+ *
+ * Numbers, lists and bars keep the state of their library (uc_numbers_field,
+ * uc_list, uc_bar) in a struct passed on setup. A new value of them is
+ * drawn incrementally by that library: a number redraws the changed digits,
+ * a list moves its highlight or scrolls, a bar fills or clears the
+ * difference. They are only redrawn completely when they are shown or
+ * their parent is redrawn.
+ *
+ * Children must lie within the bounds of their parent and widgets of the
+ * same parent must not overlap. A hidden widget leaves an empty region.
+ *
+ * Usage:
+ * 		- Declare uc_widget widgets[n] and set them up with the
+ * 		  uc_toolkit_init_* functions (all start invalid).
+ * 		- Call uc_toolkit_init_screen() with the array.
+ * 		- Change widgets with the uc_toolkit_set_* functions.
+ * 		- Call uc_toolkit_render() e.g. before every flush.
+ *
+ * Capacity can be changed by defining following macro before including
+ * this header file:
+ * 		- UC_TOOLKIT_MAX_DIRTY_RECTS: dirty regions per render pass
+ * 		  (default 8, further regions are merged into the last one).
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#ifndef UC_AVR_WIDGETS_TOOLKIT_H_
+#define UC_AVR_WIDGETS_TOOLKIT_H_
+
+#if !defined(LCD_API_INTERSECT_CLIP) || !defined(LCD_API_GET_CLIP) || !defined(LCD_API_RESTORE_CLIP)
+#error "µC-Graphics toolkit library does require LCD_API_INTERSECT_CLIP, LCD_API_GET_CLIP and LCD_API_RESTORE_CLIP makros to be set."
+#endif
+
+#include <avr/pgmspace.h>
+#include "../graphics/graphics.h"
+#include "../graphics/fonts.h"
+#include "../graphics/images.h"
+#include "../graphics/numbers.h"
+#include "../widgets/bars.h"
+#include "../widgets/list.h"
+
+#ifndef UC_TOOLKIT_MAX_DIRTY_RECTS
+	//Change here or set macro before including this header file!
+	#define UC_TOOLKIT_MAX_DIRTY_RECTS 8
+#endif
+
+#define UC_TOOLKIT_TYPE_PANEL		0
+#define UC_TOOLKIT_TYPE_LABEL		1
+#define UC_TOOLKIT_TYPE_NUMBER		2
+#define UC_TOOLKIT_TYPE_ICON		3
+#define UC_TOOLKIT_TYPE_LIST		4
+#define UC_TOOLKIT_TYPE_BAR			5
+#define UC_TOOLKIT_TYPE_CHECKBOX	6
+
+#define UC_TOOLKIT_FLAG_BIT_VISIBLE	0
+#define UC_TOOLKIT_FLAG_BIT_INVALID	1
+#define UC_TOOLKIT_FLAG_BIT_REDRAWN	2
+#define UC_TOOLKIT_FLAG_BIT_FRAME	3
+#define UC_TOOLKIT_FLAG_BIT_SHOWN	4
+#define UC_TOOLKIT_FLAG_BIT_CHANGED	5
+
+struct uc_widget_struct {
+	uint8_t type;
+	uint8_t flags;
+	int8_t parent;				//index of parent widget, -1 for none
+	uc_graphics_rect bounds;
+	const void *data;			//label/checkbox: text in RAM, icon: image, number/list/bar: state of library
+	const uint8_t *progmem_font;
+	int16_t value;				//number, bar, checkbox state, list selection
+	int16_t min;				//bar: value of empty bar
+	int16_t max;				//bar: value of full bar
+};
+
+typedef struct uc_widget_struct uc_widget;
+
+struct uc_toolkit_screen_struct {
+	uc_widget *widgets;
+	uint8_t count;
+	uc_graphics_rect dirty_rects[UC_TOOLKIT_MAX_DIRTY_RECTS];
+	uint8_t dirty_rects_count;
+};
+
+typedef struct uc_toolkit_screen_struct uc_toolkit_screen;
+
+/*
+ * Sets the fields all widgets have in common.
+ */
+void uc_toolkit_init_widget(uc_widget *widget, uint8_t type, int8_t parent,
+							uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+
+	widget->type = type;
+	widget->flags = (1 << UC_TOOLKIT_FLAG_BIT_VISIBLE) | (1 << UC_TOOLKIT_FLAG_BIT_INVALID);
+	widget->parent = parent;
+	widget->bounds.x = x;
+	widget->bounds.y = y;
+	widget->bounds.width = width;
+	widget->bounds.height = height;
+	widget->data = 0;
+	widget->progmem_font = 0;
+	widget->value = 0;
+	widget->min = 0;
+	widget->max = 0;
+}
+
+/**
+ * Sets up a panel, a container which clears its bounds.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y, width, height: bounds
+ * 		- frame: 1 to draw a frame along the bounds
+ */
+void uc_toolkit_init_panel(uc_widget *widget, int8_t parent,
+						   uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t frame) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_PANEL, parent, x, y, width, height);
+	if ( frame ) widget->flags |= (1 << UC_TOOLKIT_FLAG_BIT_FRAME);
+}
+
+/**
+ * Sets up a label.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y, width, height: bounds
+ * 		- text: text in RAM, must stay valid (change it with uc_toolkit_set_text)
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_toolkit_init_label(uc_widget *widget, int8_t parent,
+						   uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+						   const char *text, const uint8_t *progmem_font) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_LABEL, parent, x, y, width, height);
+	widget->data = text;
+	widget->progmem_font = progmem_font;
+}
+
+/**
+ * Sets up a right aligned numeric field. The bounds hold as many digits
+ * as character cells fit in (see numbers library), wider values are
+ * shown as dashes.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y, width, height: bounds
+ * 		- field: state of the number, must stay valid
+ * 		- value: initial value
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_toolkit_init_number(uc_widget *widget, int8_t parent,
+							uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+							uc_numbers_field *field, int16_t value, const uint8_t *progmem_font) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_NUMBER, parent, x, y, width, height);
+	widget->data = field;
+	widget->value = value;
+	widget->progmem_font = progmem_font;
+}
+
+/**
+ * Sets up an icon, its size is taken from the image.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y: position
+ * 		- progmem_img: image stored in progmem
+ */
+void uc_toolkit_init_icon(uc_widget *widget, int8_t parent,
+						  uint8_t x, uint8_t y, const uint8_t *progmem_img) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_ICON, parent, x, y,
+						   uc_images_get_width(progmem_img), uc_images_get_height(progmem_img));
+	widget->data = progmem_img;
+}
+
+/**
+ * Sets up a list (menu). Every row shows one item, the selected item is
+ * highlighted and always scrolled into view.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y, width, height: bounds
+ * 		- list: state of the list, must stay valid
+ * 		- progmem_items: table of pointers to strings, table and strings stored in progmem
+ * 		- count: amount of items
+ * 		- progmem_font: font stored in progmem
+ */
+void uc_toolkit_init_list(uc_widget *widget, int8_t parent,
+						  uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+						  uc_list *list, const char * const *progmem_items, uint8_t count, const uint8_t *progmem_font) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_LIST, parent, x, y, width, height);
+	widget->data = list;
+	widget->progmem_font = progmem_font;
+
+	//The list keeps selection and scroll position when it is redrawn
+	uc_list_setup_progmem(list, x, y, width, height, progmem_items, count, progmem_font);
+}
+
+/**
+ * Sets up a horizontal bar with frame. Bars smaller than 5x5 pixels have
+ * no frame.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y, width, height: bounds including frame
+ * 		- bar: state of the bar, must stay valid
+ * 		- min: value of empty bar
+ * 		- max: value of full bar (> min)
+ */
+void uc_toolkit_init_bar(uc_widget *widget, int8_t parent,
+						 uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+						 uc_bar *bar, int16_t min, int16_t max) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_BAR, parent, x, y, width, height);
+	widget->data = bar;
+	widget->value = min;
+	widget->min = min;
+	widget->max = max;
+}
+
+/**
+ * Sets up a checkbox. The box is as high as the bounds, the label is drawn
+ * right of it.
+ *
+ * params:
+ * 		- widget: widget to set up
+ * 		- parent: index of parent or -1
+ * 		- x, y, width, height: bounds
+ * 		- checked: initial state
+ * 		- text: label in RAM or 0
+ * 		- progmem_font: font stored in progmem (only needed with label)
+ */
+void uc_toolkit_init_checkbox(uc_widget *widget, int8_t parent,
+							  uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+							  uint8_t checked, const char *text, const uint8_t *progmem_font) {
+
+	uc_toolkit_init_widget(widget, UC_TOOLKIT_TYPE_CHECKBOX, parent, x, y, width, height);
+	widget->value = checked ? 1 : 0;
+	widget->data = text;
+	widget->progmem_font = progmem_font;
+}
+
+/**
+ * Sets up a screen of widgets. All widgets are drawn on the first render.
+ *
+ * params:
+ * 		- screen: screen to set up
+ * 		- widgets: widget array, parents before children
+ * 		- count: amount of widgets
+ */
+void uc_toolkit_init_screen(uc_toolkit_screen *screen, uc_widget *widgets, uint8_t count) {
+	screen->widgets = widgets;
+	screen->count = count;
+	screen->dirty_rects_count = 0;
+}
+
+/**
+ * Marks a widget invalid, it is redrawn on next render.
+ *
+ * params:
+ * 		- widget: widget to redraw
+ */
+void uc_toolkit_invalidate(uc_widget *widget) {
+	widget->flags |= (1 << UC_TOOLKIT_FLAG_BIT_INVALID);
+}
+
+/**
+ * Changes the value of a number, bar, checkbox or the selection of a list.
+ * The widget is only redrawn if the value really changes, numbers, lists
+ * and bars are updated incrementally (see file header).
+ *
+ * params:
+ * 		- widget: widget to change
+ * 		- value: new value
+ */
+void uc_toolkit_set_value(uc_widget *widget, int16_t value) {
+	if ( widget->value == value ) return;
+
+	widget->value = value;
+
+	if ( widget->type == UC_TOOLKIT_TYPE_NUMBER || widget->type == UC_TOOLKIT_TYPE_LIST || widget->type == UC_TOOLKIT_TYPE_BAR ) {
+		widget->flags |= (1 << UC_TOOLKIT_FLAG_BIT_CHANGED);
+	} else {
+		uc_toolkit_invalidate(widget);
+	}
+}
+
+/**
+ * Changes the text of a label or checkbox. Call uc_toolkit_invalidate()
+ * instead if only the content of the same buffer changed.
+ *
+ * params:
+ * 		- widget: widget to change
+ * 		- text: new text in RAM
+ */
+void uc_toolkit_set_text(uc_widget *widget, const char *text) {
+	if ( widget->data == text ) return;
+
+	widget->data = text;
+	uc_toolkit_invalidate(widget);
+}
+
+/**
+ * Shows or hides a widget. A hidden widget is cleared on next render,
+ * its children are hidden too.
+ *
+ * params:
+ * 		- widget: widget to change
+ * 		- visible: 1 to show, 0 to hide
+ */
+void uc_toolkit_set_visible(uc_widget *widget, uint8_t visible) {
+	uint8_t is_visible = (widget->flags & (1 << UC_TOOLKIT_FLAG_BIT_VISIBLE)) ? 1 : 0;
+	if ( is_visible == (visible ? 1 : 0) ) return;
+
+	widget->flags ^= (1 << UC_TOOLKIT_FLAG_BIT_VISIBLE);
+	uc_toolkit_invalidate(widget);
+}
+
+/*
+ * Adds a region to the dirty rectangles of a screen, merges it with an
+ * overlapping one or with the last one if there is no space left.
+ */
+void uc_toolkit_add_dirty_rect(uc_toolkit_screen *screen, const uc_graphics_rect *rect) {
+	for ( uint8_t i = 0; i < screen->dirty_rects_count; i++ ) {
+		if ( uc_graphics_rects_overlap(&screen->dirty_rects[i], rect) ) {
+			uc_graphics_rect_union(&screen->dirty_rects[i], rect);
+			return;
+		}
+	}
+
+	if ( screen->dirty_rects_count == UC_TOOLKIT_MAX_DIRTY_RECTS ) {
+		uc_graphics_rect_union(&screen->dirty_rects[UC_TOOLKIT_MAX_DIRTY_RECTS - 1], rect);
+		return;
+	}
+
+	screen->dirty_rects[screen->dirty_rects_count++] = *rect;
+}
+
+/*
+ * Selects the item of a list widget given by its value, the value is
+ * clamped to the items.
+ *
+ * returns: 1 if something has been drawn, 0 if not.
+ */
+uint8_t uc_toolkit_select_item(uc_widget *widget) {
+	uc_list *list = (uc_list*)widget->data;
+	uint8_t item = (widget->value < 0) ? 0 : ((widget->value > 255) ? 255 : widget->value);
+
+	uint8_t drawn = uc_list_select(list, item);
+	widget->value = list->selected;
+	return drawn;
+}
+
+/*
+ * Draws the content of a visible widget, the bounds are cleared already.
+ */
+void uc_toolkit_draw_widget(uc_widget *widget) {
+	uc_graphics_rect *bounds = &widget->bounds;
+
+	switch ( widget->type ) {
+		case UC_TOOLKIT_TYPE_PANEL:
+			if ( widget->flags & (1 << UC_TOOLKIT_FLAG_BIT_FRAME) ) {
+				uc_graphics_draw_rect(bounds->x, bounds->y, bounds->width, bounds->height, 1);
+			}
+			break;
+
+		case UC_TOOLKIT_TYPE_LABEL:
+			if ( widget->data ) {
+				uc_fonts_draw_string((char*)widget->data, bounds->x, bounds->y, 0, 0, widget->progmem_font);
+			}
+			break;
+
+		case UC_TOOLKIT_TYPE_NUMBER: {
+			//Right align the cells which fit into the bounds
+			uint8_t cell_width = uc_fonts_get_char_width(widget->progmem_font) + 1;
+			uint8_t cells = bounds->width / cell_width;
+			uint8_t x = bounds->x + bounds->width - cells * cell_width;
+
+			uc_numbers_field *field = (uc_numbers_field*)widget->data;
+			uc_numbers_field_init(field, x, bounds->y, cells, 0, ' ', widget->progmem_font);
+			uc_numbers_field_update(field, widget->value);
+			break;
+		}
+
+		case UC_TOOLKIT_TYPE_ICON:
+			uc_images_draw(bounds->x, bounds->y, 0, (const uint8_t*)widget->data);
+			break;
+
+		case UC_TOOLKIT_TYPE_LIST:
+			uc_list_draw((uc_list*)widget->data);
+			uc_toolkit_select_item(widget);
+			break;
+
+		case UC_TOOLKIT_TYPE_BAR: {
+			uint8_t frame = bounds->width >= 5 && bounds->height >= 5;
+			uc_bar *bar = (uc_bar*)widget->data;
+
+			uc_bar_init(bar, bounds->x, bounds->y, bounds->width, bounds->height,
+						UC_BAR_DIRECTION_RIGHT, widget->min, widget->max, frame);
+			uc_bar_set_value(bar, widget->value, 0);
+			break;
+		}
+
+		case UC_TOOLKIT_TYPE_CHECKBOX: {
+			uint8_t size = bounds->height;
+			uc_graphics_draw_rect(bounds->x, bounds->y, size, size, 1);
+			if ( widget->value && size > 4 ) uc_graphics_fill_rect(bounds->x + 2, bounds->y + 2, size - 4, size - 4, 1);
+
+			if ( widget->data ) {
+				uc_fonts_draw_string((char*)widget->data, bounds->x + size + 2, bounds->y, 0, 0, widget->progmem_font);
+			}
+			break;
+		}
+	}
+}
+
+/*
+ * Draws the new value of a number, list or bar through its library, only
+ * the changed pixels are drawn. Changed receives the region to send.
+ */
+void uc_toolkit_update_widget(uc_widget *widget, uc_graphics_rect *changed) {
+	*changed = widget->bounds;
+
+	switch ( widget->type ) {
+		case UC_TOOLKIT_TYPE_NUMBER:
+			if ( !uc_numbers_field_update((uc_numbers_field*)widget->data, widget->value) ) changed->width = 0;
+			break;
+
+		case UC_TOOLKIT_TYPE_LIST:
+			if ( !uc_toolkit_select_item(widget) ) changed->width = 0;
+			break;
+
+		case UC_TOOLKIT_TYPE_BAR:
+			uc_bar_set_value((uc_bar*)widget->data, widget->value, changed);
+			break;
+	}
+}
+
+/**
+ * Redraws all invalid widgets of a screen in paint order and all children
+ * of redrawn widgets and updates numbers, lists and bars whose value
+ * changed. Every widget is clipped to its bounds (within the clip
+ * rectangle set by the caller). The redrawn regions are stored in
+ * screen->dirty_rects.
+ *
+ * params:
+ * 		- screen: screen to render
+ *
+ * returns: amount of redrawn or updated widgets.
+ */
+uint8_t uc_toolkit_render(uc_toolkit_screen *screen) {
+	uint8_t redrawn = 0;
+	screen->dirty_rects_count = 0;
+
+	LCD_API_CLIP previous_clip;
+	LCD_API_GET_CLIP(&previous_clip);
+
+	for ( uint8_t i = 0; i < screen->count; i++ ) {
+		uc_widget *widget = &screen->widgets[i];
+		uc_widget *parent = (widget->parent >= 0) ? &screen->widgets[widget->parent] : 0;
+
+		//Parents are handled first, so their flags are up to date
+		uint8_t parent_shown = !parent || (parent->flags & (1 << UC_TOOLKIT_FLAG_BIT_SHOWN));
+		uint8_t parent_redrawn = parent && (parent->flags & (1 << UC_TOOLKIT_FLAG_BIT_REDRAWN));
+		uint8_t invalid = widget->flags & (1 << UC_TOOLKIT_FLAG_BIT_INVALID);
+		uint8_t changed = widget->flags & (1 << UC_TOOLKIT_FLAG_BIT_CHANGED);
+
+		widget->flags &= ~((1 << UC_TOOLKIT_FLAG_BIT_INVALID) | (1 << UC_TOOLKIT_FLAG_BIT_SHOWN));
+
+		if ( !parent_shown || !(widget->flags & (1 << UC_TOOLKIT_FLAG_BIT_VISIBLE)) ) {
+			//Clear a widget which has just been hidden, unless its parent has been redrawn anyway
+			if ( invalid && parent_shown && !parent_redrawn ) {
+				uc_graphics_fill_rect(widget->bounds.x, widget->bounds.y, widget->bounds.width, widget->bounds.height, 0);
+				uc_toolkit_add_dirty_rect(screen, &widget->bounds);
+			}
+			continue;
+		}
+
+		widget->flags |= (1 << UC_TOOLKIT_FLAG_BIT_SHOWN);
+		widget->flags &= ~(1 << UC_TOOLKIT_FLAG_BIT_CHANGED);
+
+		LCD_API_INTERSECT_CLIP(widget->bounds.x, widget->bounds.y, widget->bounds.width, widget->bounds.height);
+
+		if ( !invalid && !parent_redrawn ) {
+			if ( changed ) {
+				uc_graphics_rect changed_rect;
+				uc_toolkit_update_widget(widget, &changed_rect);
+
+				if ( changed_rect.width ) {
+					uc_toolkit_add_dirty_rect(screen, &changed_rect);
+					redrawn++;
+				}
+			}
+
+			LCD_API_RESTORE_CLIP(&previous_clip);
+			continue;
+		}
+
+		uc_graphics_fill_rect(widget->bounds.x, widget->bounds.y, widget->bounds.width, widget->bounds.height, 0);
+		uc_toolkit_draw_widget(widget);
+		LCD_API_RESTORE_CLIP(&previous_clip);
+
+		widget->flags |= (1 << UC_TOOLKIT_FLAG_BIT_REDRAWN);
+
+		//Children lie within the region of their parent
+		if ( !parent_redrawn ) uc_toolkit_add_dirty_rect(screen, &widget->bounds);
+		redrawn++;
+	}
+
+	for ( uint8_t i = 0; i < screen->count; i++ ) {
+		screen->widgets[i].flags &= ~(1 << UC_TOOLKIT_FLAG_BIT_REDRAWN);
+	}
+
+	return redrawn;
+}
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * Host stand-in for avr-libc's <avr/pgmspace.h>: there is only one address
+ * space, so progmem data is read like any other memory.
+ */
+
+#ifndef UC_HOST_AVR_PGMSPACE_H_
+#define UC_HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(address)	(*(const uint8_t*)(address))
+#define pgm_read_word(address)	(*(const uint16_t*)(address))
+#define pgm_read_ptr(address)	(*(void * const*)(address))
+
+#define memcpy_P	memcpy
+#define strlen_P	strlen
+
+#endif
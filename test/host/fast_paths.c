@@ -0,0 +1,950 @@
+/*
+ * Host runner which checks the fast drawing paths of the LCD library
+ * against the reference paths.
+ *
+ * The runner is built three times (see Makefile): once as usual, once
+ * with a glyph cache (UC_FONTS_GLYPH_CACHE_SLOTS) and once with
+ * LCD_API_REFERENCE_PATHS, which makes graphics, fonts and images draw
+ * every pixel through LCD_API_SET_PIXEL. The reference build also replaces
+ * the byte wise LCD calls (LCD_API_BLIT, LCD_API_SAVE_RECT,
+ * LCD_API_RESTORE_RECT and LCD_API_BLIT_CANVAS) by the per pixel versions
+ * below, so sprites and canvases are compared too.
+ *
+ * All builds draw the same cases: every primitive is drawn onto a random
+ * background with random geometry (partly outside the display), a random
+ * clip rectangle in three of four cases and a random raster operation.
+ * One case in four draws into a canvas of random size, which is copied to
+ * the display afterwards. Coordinates are uint8_t and wrap around after
+ * 255, so images and strings end before 255 and rectangles before 256
+ * (lines, circles and polygons compute their pixels in a wider type).
+ *
+ * Images are drawn in all layouts (hv, vh and pm). Texts, lists and text
+ * layouts are drawn with fonts of every format, built at start from the
+ * 5x8 font: bc, bcs with an index in RAM, proportional (pr) with kerning,
+ * ranged (rg) with UTF-8 texts, 10x16 and a 15x24 font whose characters
+ * are too big to be blitted.
+ *
+ * After every case the 1024 bytes of the display buffer are written to a
+ * file (reference build) or compared with that file (fast builds). Every
+ * primitive also gets a checksum over the LCD_API_GET_BUFFER_CHECKSUM() of
+ * all its cases, which is stored after its buffers and compared as well.
+ * It is printed along with the operations per second of the primitive.
+ *
+ * Usage:
+ * 		- fast_paths -w FILE: draws all cases and writes the buffers to FILE
+ * 		- fast_paths -c FILE: draws all cases and compares the buffers with FILE
+ *
+ * Exit code is 1 if a buffer differs or the file does not fit.
+ *
+ *
+ *
+ *
+ * This is free software:
+ *
+ * 		- You are allowed to execute the code how
+ * 		  you want to.
+ * 		- This code is open source, you are allowed
+ * 		  to inspect what the code does.
+ * 		- You are allowed to share/redistribute the
+ * 		  code on your own to make it accessible to
+ * 		  others or for any reason.
+ * 		- You are allowed to modify the code and
+ * 		  improve it. Hopefully you share your
+ * 		  modifications to make it available to all.
+ *
+ * Check out my website:	https://hedgehogs-mind.com
+ * My github account:	  	https://github.com/hedgehogs-mind
+ * Contact me:				peter@hedgehogs-mind.com
+ *
+ *
+ * Yours sincerely,
+ *
+ * Peter Kuhmann
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "lcd_config.h"
+#include "../../library/graphics/lcd.h"
+
+#ifdef LCD_API_REFERENCE_PATHS
+
+/*
+ * Reads a byte from RAM or progmem.
+ */
+uint8_t reference_read_byte(const uint8_t *data, uint16_t index, uint8_t progmem) {
+	return progmem ? pgm_read_byte(&data[index]) : data[index];
+}
+
+/*
+ * Draws a bitmap in page layout pixel by pixel, see uc_lcd_blit.
+ */
+void reference_blit(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+					const uint8_t *bitmap, const uint8_t *mask, uint8_t progmem) {
+
+	for ( uint8_t row = 0; row < height; row++ ) {
+		for ( uint8_t column = 0; column < width; column++ ) {
+			uint16_t index = (row/8) * width + column;
+			uint8_t bit = 1 << (row%8);
+
+			if ( x + column > 255 || y + row > 255 ) continue;
+			if ( mask && !(reference_read_byte(mask, index, progmem) & bit) ) continue;
+
+			LCD_API_SET_PIXEL(x + column, y + row, (reference_read_byte(bitmap, index, progmem) & bit) ? 1 : 0);
+		}
+	}
+}
+
+/*
+ * Saves the pages touched by a rectangle pixel by pixel, see uc_lcd_save_rect.
+ */
+void reference_save_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t *destination) {
+	if ( height == 0 ) return;
+
+	uint8_t target_pages = (LCD_API_GET_TARGET_HEIGHT() + 7)/8;
+	uint8_t first_page = y/8;
+	uint8_t last_page = (y + height - 1)/8;
+	uint16_t index = 0;
+
+	for ( uint8_t page = first_page; page <= last_page; page++ ) {
+		for ( uint8_t i = 0; i < width; i++ ) {
+			if ( page < target_pages && x + i < LCD_API_GET_TARGET_WIDTH() ) {
+				uint8_t data = 0;
+				for ( uint8_t bit = 0; bit < 8; bit++ ) data |= LCD_API_GET_PIXEL(x + i, page*8 + bit) << bit;
+				destination[index] = data;
+			}
+			index++;
+		}
+	}
+}
+
+/*
+ * Writes the rows of a saved rectangle back pixel by pixel, without
+ * raster operation and clip rectangle, see uc_lcd_restore_rect.
+ */
+void reference_restore_rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *source) {
+	uint8_t previous_op = LCD_API_GET_RASTER_OP();
+	LCD_API_CLIP previous_clip;
+
+	LCD_API_SET_RASTER_OP(LCD_RASTER_OP_COPY);
+	LCD_API_GET_CLIP(&previous_clip);
+	LCD_API_RESET_CLIP();
+
+	for ( uint16_t row = y; row < y + height && row < 256; row++ ) {
+		uint16_t page_index = (row/8 - y/8) * width;
+
+		for ( uint8_t i = 0; i < width && x + i < 256; i++ ) {
+			LCD_API_SET_PIXEL(x + i, row, (source[page_index + i] >> (row%8)) & 0x01);
+		}
+	}
+
+	LCD_API_SET_RASTER_OP(previous_op);
+	LCD_API_RESTORE_CLIP(&previous_clip);
+}
+
+/*
+ * Composites a canvas pixel by pixel, see uc_lcd_blit_canvas.
+ */
+void reference_blit_canvas(uint8_t x, uint8_t y, const uc_lcd_canvas *canvas, const uc_lcd_canvas *mask) {
+	reference_blit(x, y, canvas->width, canvas->height, canvas->buffer, mask ? mask->buffer : 0, 0);
+}
+
+#undef LCD_API_BLIT
+#undef LCD_API_SAVE_RECT
+#undef LCD_API_RESTORE_RECT
+#undef LCD_API_BLIT_CANVAS
+#define LCD_API_BLIT(x, y, width, height, bitmap, mask, progmem) reference_blit(x, y, width, height, bitmap, mask, progmem)
+#define LCD_API_SAVE_RECT(x, y, width, height, destination) reference_save_rect(x, y, width, height, destination)
+#define LCD_API_RESTORE_RECT(x, y, width, height, source) reference_restore_rect(x, y, width, height, source)
+#define LCD_API_BLIT_CANVAS(x, y, canvas, mask) reference_blit_canvas(x, y, canvas, mask)
+
+#endif
+
+//Both proportional fixture fonts are kerned
+#define UC_FONTS_KERNING_SLOTS 2
+
+#include "../../library/graphics/graphics.h"
+#include "../../library/graphics/images.h"
+#include "../../library/graphics/fonts.h"
+#include "../../library/graphics/sprites.h"
+#include "../../library/graphics/text_layout.h"
+#include "../../library/widgets/list.h"
+#include "../../library/fonts/AVR_5_by_8_font_bcs_hv.h"
+
+#define CASES_PER_PRIMITIVE		256
+#define TIMING_SECONDS			0.1
+#define MAX_REPORTED_CASES		4
+#define TEXT_BYTES				96
+
+#ifdef LCD_API_REFERENCE_PATHS
+	#define PATH_NAME "reference"
+#elif UC_FONTS_GLYPH_CACHE_SLOTS > 0
+	#define PATH_NAME "fast (glyph cache)"
+#else
+	#define PATH_NAME "fast"
+#endif
+
+/* Test images, 21x13 pixels row by row (hv) and 13x21 column by column (vh) */
+const uint8_t test_image_hv[3 + 35] PROGMEM = {
+	UC_IMG_SETTINGS_BIT_HV_MASK, 21, 13,
+	0xA5, 0x4D, 0xCA, 0x18, 0x25, 0x30, 0xBB, 0x1D, 0x6D, 0x13, 0x2C, 0xDE, 0xD6, 0x23, 0x7B, 0x2E,
+	0xD9, 0x1E, 0x3F, 0x72, 0x1F, 0xCB, 0x19, 0x71, 0x17, 0x44, 0x94, 0xD6, 0x49, 0x3C, 0x9D, 0x5C,
+	0x34, 0x60, 0xBE
+};
+
+const uint8_t test_image_vh[3 + 35] PROGMEM = {
+	UC_IMG_SETTINGS_BIT_VH_MASK, 13, 21,
+	0x31, 0x20, 0x1E, 0x69, 0xFE, 0xDA, 0xA0, 0xEE, 0xE8, 0xB9, 0x99, 0x7F, 0x5C, 0x7C, 0x29, 0x99,
+	0xFD, 0xAF, 0xE5, 0x93, 0x25, 0x3C, 0xD6, 0x54, 0xAF, 0x4D, 0xFA, 0xD7, 0x14, 0x27, 0xA0, 0xAE,
+	0xB3, 0xFE, 0xE9
+};
+
+/* Test image of 17x11 pixels in page bytes (pm) */
+const uint8_t test_image_pm[3 + 34] PROGMEM = {
+	UC_IMG_SETTINGS_BIT_PM_MASK, 17, 11,
+	0xE7, 0xEE, 0xE7, 0x61, 0x5E, 0xF3, 0x5F, 0x30, 0xE4, 0x9B, 0x48, 0x2E, 0x15, 0xCA, 0xE7, 0x50,
+	0x07, 0x20, 0x1E, 0x12, 0x61, 0x7B, 0x0F, 0xED, 0xA7, 0xE1, 0x64, 0x77, 0x96, 0xFF, 0x02, 0x2B,
+	0xEA, 0x8E
+};
+
+/* Sprites in page layout: 12x10 ring with mask, 8x8 block without mask */
+const uint8_t test_sprite_ring[2*12] PROGMEM = {
+	0x78, 0x86, 0x02, 0x01, 0x01, 0x31, 0x31, 0x01, 0x01, 0x02, 0x86, 0x78,
+	0x00, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x01, 0x01, 0x00
+};
+
+const uint8_t test_sprite_ring_mask[2*12] PROGMEM = {
+	0x78, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0x78,
+	0x00, 0x01, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x01, 0x00
+};
+
+const uint8_t test_sprite_block[8] PROGMEM = {
+	0xFF, 0x81, 0xBD, 0xA5, 0xA5, 0xBD, 0x81, 0xFF
+};
+
+char test_text[] = "Fast paths: 0123 ABCxyz, AVATAR LTo jiffy r. and ~!";
+
+/* UTF-8 text for ranged fonts: Greek letters, an en dash and an umlaut
+ * the fonts do not have, a euro sign and an invalid byte */
+char test_text_utf8[] = "\xCE\xA9mega \xCE\x91\xE2\x80\x93\xCE\xA9 12\xE2\x82\xAC \xC3\xBC\xFF AV To jr.";
+
+/* Kerning of both proportional fixture fonts, sorted by left character */
+const uint8_t test_kerning[] PROGMEM = {
+	'A', 'V', (uint8_t)-1,
+	'L', 'T', (uint8_t)-2,
+	'T', 'o', (uint8_t)-1,
+	'V', 'A', (uint8_t)-1,
+	'f', 'f', 1,
+	'r', '.', (uint8_t)-1,
+	0
+};
+
+/* Code point ranges of the ranged fixture fonts, code point 0 is the null char */
+const uint16_t test_ranges[][2] = {
+	{ 0, 0 },
+	{ 32, 126 },
+	{ 0x391, 0x3A9 },
+	{ 0x20AC, 0x20AC }
+};
+
+#define TEST_RANGES_COUNT (sizeof(test_ranges) / sizeof(test_ranges[0]))
+
+/*
+ * Fixture fonts of every format, built from AVR_5_by_8_font_bcs_hv by
+ * build_fonts() (progmem is plain RAM on the host). Sizes are the worst
+ * case of 256 characters of full size.
+ */
+#define FONT_BYTES(bytes_per_char) (3 + 256 * (bytes_per_char))
+
+uint8_t font_bc_vh[FONT_BYTES(1 + 5)];
+uint8_t font_bcs_pm[FONT_BYTES(1 + 5)];
+uint8_t font_bcs_pr_hv[FONT_BYTES(3 + 5)];
+uint8_t font_rg_vh[FONT_BYTES(1 + 5)];
+uint8_t font_rg_pr_pm_10_by_16[FONT_BYTES(3 + 20)];
+uint8_t font_bc_hv_15_by_24[FONT_BYTES(1 + 45)];
+uint16_t font_bcs_pm_offsets[96];
+
+//15x24 characters take 45 bytes, more than UC_FONTS_MAX_GLYPH_BYTES: pixel by pixel
+const uint8_t *test_fonts[] = {
+	AVR_5_by_8_font_bcs_hv,
+	font_bc_vh,
+	font_bcs_pm,
+	font_bcs_pr_hv,
+	font_rg_vh,
+	font_rg_pr_pm_10_by_16,
+	font_bc_hv_15_by_24
+};
+
+#define TEST_FONTS_COUNT (sizeof(test_fonts) / sizeof(test_fonts[0]))
+
+uint32_t random_state;
+
+/* Canvas render target of one case in four */
+uint8_t canvas_buffer[1024];
+uc_lcd_canvas canvas;
+uint8_t canvas_used;
+
+/*
+ * Xorshift generator, so both builds draw exactly the same cases.
+ */
+uint32_t random_next(void) {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+/*
+ * Retrieves a random number from 0 to limit-1.
+ */
+uint16_t random_below(uint16_t limit) {
+	return random_next() % limit;
+}
+
+/*
+ * Retrieves a coordinate, mostly around the display, sometimes at the end
+ * of the uint8_t range.
+ */
+uint8_t random_coordinate(void) {
+	return random_below(8) ? random_below(160) : 248 + random_below(8);
+}
+
+/*
+ * Retrieves a width or height, mostly small, sometimes up to the end of
+ * the uint8_t range. Coordinate + size does not exceed 256.
+ */
+uint8_t random_size(uint8_t coordinate) {
+	uint16_t size = random_below(8) ? random_below(80) : random_below(256);
+	return (coordinate + size > 256) ? 256 - coordinate : size;
+}
+
+/*
+ * Retrieves a coordinate where something of size pixels ends before 255.
+ */
+uint8_t random_coordinate_for(uint8_t size) {
+	uint8_t coordinate = random_coordinate();
+	return (coordinate + size > 255) ? 255 - size : coordinate;
+}
+
+/*
+ * Retrieves a pen position for text. 'j' of the proportional fonts starts
+ * scale pixels left of the pen, which must not wrap around below 0.
+ */
+uint8_t random_text_x(void) {
+	uint8_t x = random_coordinate();
+	return (x < 4) ? 4 : x;
+}
+
+const uint8_t *random_font(void) {
+	return test_fonts[random_below(TEST_FONTS_COUNT)];
+}
+
+char *get_test_text(const uint8_t *font) {
+	return (uc_fonts_get_settings(font) & UC_FONTS_SETTINGS_BIT_RG_MASK) ? test_text_utf8 : test_text;
+}
+
+/*
+ * Cuts a text until it ends before 255 when drawn at x with scale. A cut
+ * UTF-8 sequence is left in place, it is read as an invalid one.
+ */
+void fit_text(char *text, uint8_t x, uint8_t scale, const uint8_t *font) {
+	uint8_t length = strlen(text);
+
+	while ( length > 0 && x + uc_fonts_get_string_width(text, font) * scale > 255 ) {
+		text[--length] = 0;
+	}
+}
+
+/*
+ * Reads a pixel of a character of AVR_5_by_8_font_bcs_hv, 0 for empty
+ * characters.
+ */
+uint8_t get_source_pixel(uint8_t char_code, uint8_t x, uint8_t y) {
+	const uint8_t *font = AVR_5_by_8_font_bcs_hv;
+	uint16_t index = uc_fonts_get_char_index(char_code, font);
+
+	if ( !pgm_read_byte(&font[index]) ) return 0;
+	return uc_fonts_get_bitmap_pixel(&font[index + 1], uc_fonts_get_settings(font), 5, 8, x, y);
+}
+
+/*
+ * Writes the pixels of a source character from first_column on, scaled
+ * and in the layout of the font (hv, vh or pm). Returns the index after
+ * the pixel bytes.
+ */
+uint16_t put_bitmap(uint8_t *font, uint16_t index, uint8_t char_code, uint8_t first_column, uint8_t width, uint8_t scale) {
+	uint8_t settings = font[0];
+	uint8_t height = font[2];
+	uint16_t size = uc_fonts_get_bitmap_size(settings, width, height);
+
+	memset(&font[index], 0, size);
+
+	for ( uint8_t y = 0; y < height; y++ ) {
+		for ( uint8_t x = 0; x < width; x++ ) {
+			if ( !get_source_pixel(char_code, first_column + x/scale, y/scale) ) continue;
+
+			uint16_t bit;
+			if ( settings & UC_FONTS_SETTINGS_BIT_PM_MASK ) bit = ((y/8) * width + x) * 8 + y%8;
+			else if ( settings & UC_FONTS_SETTINGS_BIT_HV_MASK ) bit = y * width + x;
+			else bit = x * height + y;
+
+			font[index + bit/8] |= 1 << (bit%8);
+		}
+	}
+
+	return index + size;
+}
+
+/*
+ * Writes a source character in the format of the font. Proportional
+ * characters are trimmed to their pixel columns, empty characters of bcs
+ * and proportional fonts are a single 0 byte. Returns the index after the
+ * character.
+ */
+uint16_t put_char(uint8_t *font, uint16_t index, uint8_t char_code, uint8_t scale) {
+	uint8_t settings = font[0];
+	uint8_t first = 5;
+	uint8_t last = 0;
+
+	for ( uint8_t x = 0; x < 5; x++ ) {
+		for ( uint8_t y = 0; y < 8; y++ ) {
+			if ( !get_source_pixel(char_code, x, y) ) continue;
+			if ( x < first ) first = x;
+			last = x;
+		}
+	}
+
+	if ( first > last && (settings & (UC_FONTS_SETTINGS_BIT_BCS_MASK | UC_FONTS_SETTINGS_BIT_PR_MASK)) ) {
+		font[index] = 0;
+		return index + 1;
+	}
+
+	if ( settings & UC_FONTS_SETTINGS_BIT_PR_MASK ) {
+		//'j' reaches one pixel left of the pen position
+		uint8_t shift = (char_code == 'j') ? 1 : 0;
+
+		font[index] = (last + 2 - shift) * scale;
+		font[index + 1] = (last - first + 1) * scale;
+		font[index + 2] = (uint8_t)(((int8_t)first - shift) * scale);
+		return put_bitmap(font, index + 3, char_code, first, (last - first + 1) * scale, scale);
+	}
+
+	font[index] = (first <= last) ? 1 : 0;
+	return put_bitmap(font, index + 1, char_code, 0, 5 * scale, scale);
+}
+
+/*
+ * Builds a font of all 256 characters or, for ranged fonts, of the code
+ * points of test_ranges. Code points above 127 get the pixels of a latin
+ * capital letter.
+ */
+void build_font(uint8_t *font, uint8_t settings, uint8_t scale) {
+	uint16_t index = 3;
+
+	font[0] = settings;
+	font[1] = 5 * scale;
+	font[2] = 8 * scale;
+
+	if ( !(settings & UC_FONTS_SETTINGS_BIT_RG_MASK) ) {
+		for ( uint16_t code = 0; code < 256; code++ ) index = put_char(font, index, code, scale);
+		return;
+	}
+
+	font[3] = TEST_RANGES_COUNT;
+	index = 4 + 6 * TEST_RANGES_COUNT;
+
+	for ( uint8_t i = 0; i < TEST_RANGES_COUNT; i++ ) {
+		uint8_t *range = &font[4 + 6 * i];
+		range[0] = test_ranges[i][0] & 0xFF;
+		range[1] = test_ranges[i][0] >> 8;
+		range[2] = test_ranges[i][1] & 0xFF;
+		range[3] = test_ranges[i][1] >> 8;
+		range[4] = index & 0xFF;
+		range[5] = index >> 8;
+
+		for ( uint16_t code = test_ranges[i][0]; code <= test_ranges[i][1]; code++ ) {
+			index = put_char(font, index, (code < 128) ? code : 'A' + code % 26, scale);
+		}
+	}
+}
+
+/*
+ * Builds the fixture fonts and registers their indices and kernings.
+ */
+void build_fonts(void) {
+	build_font(font_bc_vh, UC_FONTS_SETTINGS_BIT_BC_MASK | UC_FONTS_SETTINGS_BIT_VH_MASK, 1);
+	build_font(font_bcs_pm, UC_FONTS_SETTINGS_BIT_BCS_MASK | UC_FONTS_SETTINGS_BIT_PM_MASK, 1);
+	build_font(font_bcs_pr_hv, UC_FONTS_SETTINGS_BIT_BCS_MASK | UC_FONTS_SETTINGS_BIT_PR_MASK | UC_FONTS_SETTINGS_BIT_HV_MASK, 1);
+	build_font(font_rg_vh, UC_FONTS_SETTINGS_BIT_RG_MASK | UC_FONTS_SETTINGS_BIT_VH_MASK, 1);
+	build_font(font_rg_pr_pm_10_by_16, UC_FONTS_SETTINGS_BIT_RG_MASK | UC_FONTS_SETTINGS_BIT_PR_MASK | UC_FONTS_SETTINGS_BIT_PM_MASK, 2);
+	build_font(font_bc_hv_15_by_24, UC_FONTS_SETTINGS_BIT_BC_MASK | UC_FONTS_SETTINGS_BIT_HV_MASK, 3);
+
+	uc_fonts_register_progmem_index(AVR_5_by_8_font_bcs_hv, AVR_5_by_8_font_bcs_hv_index);
+	uc_fonts_build_index(font_bcs_pm, font_bcs_pm_offsets, 32, 96);
+	uc_fonts_set_kerning(font_bcs_pr_hv, test_kerning);
+	uc_fonts_set_kerning(font_rg_pr_pm_10_by_16, test_kerning);
+}
+
+const uint8_t *random_pattern(void) {
+	switch ( random_below(3) ) {
+		case 0: return UC_GRAPHICS_PATTERN_GRAY_50;
+		case 1: return UC_GRAPHICS_PATTERN_GRAY_25;
+		default: return UC_GRAPHICS_PATTERN_HATCH_DIAGONAL;
+	}
+}
+
+void draw_fill_rect(void) {
+	uint8_t x = random_coordinate();
+	uint8_t y = random_coordinate();
+	uc_graphics_fill_rect(x, y, random_size(x), random_size(y), random_below(2));
+}
+
+void draw_invert_rect(void) {
+	uint8_t x = random_coordinate();
+	uint8_t y = random_coordinate();
+	uc_graphics_invert_rect(x, y, random_size(x), random_size(y));
+}
+
+void draw_rect(void) {
+	uint8_t x = random_coordinate();
+	uint8_t y = random_coordinate();
+	uc_graphics_draw_rect(x, y, random_size(x), random_size(y), random_below(2));
+}
+
+void draw_line(void) {
+	uc_graphics_draw_line(random_coordinate(), random_coordinate(), random_coordinate(), random_coordinate(), random_below(2));
+}
+
+void draw_fill_rect_pattern(void) {
+	uint8_t x = random_coordinate();
+	uint8_t y = random_coordinate();
+	uc_graphics_fill_rect_pattern(x, y, random_size(x), random_size(y), random_pattern());
+}
+
+void draw_fill_circle(void) {
+	uc_graphics_fill_circle(random_coordinate(), random_coordinate(), random_size(0), random_below(2));
+}
+
+void draw_fill_circle_pattern(void) {
+	uc_graphics_fill_circle_pattern(random_coordinate(), random_coordinate(), random_size(0), random_pattern());
+}
+
+void draw_fill_polygon(void) {
+	uc_graphics_point points[6];
+	uc_graphics_edge edges[6];
+	uint8_t count = 3 + random_below(4);
+
+	for ( uint8_t i = 0; i < count; i++ ) {
+		points[i].x = random_coordinate();
+		points[i].y = random_coordinate();
+	}
+
+	if ( random_below(2) ) {
+		uc_graphics_fill_polygon(points, count, edges, 6, random_below(2));
+	} else {
+		uc_graphics_fill_polygon_pattern(points, count, edges, 6, random_pattern());
+	}
+}
+
+void draw_copy_rect(void) {
+	uint8_t src_x = random_coordinate();
+	uint8_t src_y = random_coordinate();
+	uint8_t dst_x = random_coordinate();
+	uint8_t dst_y = random_coordinate();
+	uint8_t width = random_size(src_x);
+	uint8_t height = random_size(src_y);
+
+	uc_graphics_copy_rect(src_x, src_y, width, height, dst_x, dst_y);
+}
+
+void draw_scroll_rect(void) {
+	uint8_t x = random_coordinate();
+	uint8_t y = random_coordinate();
+	uc_graphics_scroll_rect(x, y, random_size(x), random_size(y),
+							(int8_t)random_below(41) - 20, (int8_t)random_below(41) - 20, random_below(2));
+}
+
+void draw_flood_fill(void) {
+	uc_graphics_fill_seed seeds[32];
+	uc_graphics_flood_fill(random_below(128), random_below(64), random_below(2), seeds, 32);
+}
+
+void draw_image(void) {
+	const uint8_t *images[] = { test_image_hv, test_image_vh, test_image_pm };
+	const uint8_t *image = images[random_below(3)];
+	uint8_t x = random_coordinate_for(uc_images_get_width(image));
+	uint8_t y = random_coordinate_for(uc_images_get_height(image));
+
+	uc_images_draw(x, y, random_below(2), image);
+}
+
+/*
+ * Gray rows for uc_images_draw_gray, a diagonal gradient.
+ */
+void read_gray_row(uint8_t row, uint8_t *gray, void *context) {
+	uint8_t width = *(uint8_t*)context;
+	for ( uint8_t i = 0; i < width; i++ ) gray[i] = (row * 9 + i * 5) & 0xFF;
+}
+
+void draw_gray_image(void) {
+	uint8_t gray_row[80];
+	uint8_t page_bytes[80];
+	int16_t error_row[80];
+	uint8_t width = random_below(80);
+	uint8_t height = random_below(80);
+	uint8_t x = random_coordinate_for(width);
+	uint8_t y = random_coordinate_for(height);
+	uint8_t mode = random_below(2) ? UC_IMAGES_DITHER_BAYER : UC_IMAGES_DITHER_FLOYD_STEINBERG;
+
+	uc_images_draw_gray(x, y, width, height, mode, read_gray_row, &width, gray_row, page_bytes, error_row);
+}
+
+void draw_string(void) {
+	const uint8_t *font = random_font();
+	char text[TEXT_BYTES];
+	uint8_t x = random_text_x();
+	uint8_t y = random_coordinate_for(uc_fonts_get_char_height(font));
+	uint8_t white = random_below(2);
+
+	strcpy(text, get_test_text(font));
+	fit_text(text, x, 1, font);
+	uc_fonts_draw_string(text, x, y, white, random_below(2), font);
+}
+
+void draw_string_scaled(void) {
+	const uint8_t *font = random_font();
+	char text[TEXT_BYTES];
+	uint8_t scale = 1 + random_below(4);
+	uint8_t x = random_text_x();
+	uint8_t y = random_coordinate_for(uc_fonts_get_char_height(font) * scale);
+	uint8_t white = random_below(2);
+
+	strcpy(text, get_test_text(font));
+	fit_text(text, x, scale, font);
+	uc_fonts_draw_string_scaled(text, x, y, scale, white, random_below(2), font);
+}
+
+void draw_text(void) {
+	const uint8_t *font = random_font();
+	uint8_t x = random_text_x();
+	uint8_t y = random_coordinate();
+	uint8_t max_x = random_below(4) ? random_coordinate() : 255;
+	uint8_t max_y = random_coordinate();
+	uint8_t white = random_below(2);
+
+	uc_fonts_draw_text(get_test_text(font), x, y, random_below(3), max_x, max_y, white, random_below(2), font);
+}
+
+/*
+ * Lays out the test text in a box, draws it and scrolls it around. Boxes
+ * stay lower than 128 pixels, so scrolls fit into int8_t.
+ */
+void draw_text_layout(void) {
+	uc_text_layout layout;
+	const uint8_t *font = random_font();
+	uint8_t x = random_text_x();
+	uint8_t width = random_size(x);
+	uint8_t height = random_below(80);
+	uint8_t y = random_coordinate_for(height);
+
+	uc_text_layout_init(&layout, get_test_text(font), 0, x, y, width, height, random_below(3), random_below(3), font);
+	uc_text_layout_draw(&layout);
+
+	for ( uint8_t step = 0; step < 3; step++ ) {
+		uc_text_layout_scroll(&layout, random_below(layout.lines_count + 1));
+	}
+}
+
+/*
+ * Entries of the list case: index and a part of the test text, cut to
+ * end before 255.
+ */
+void get_list_entry(uint8_t index, char *buffer, void *context) {
+	uc_list *list = context;
+
+	snprintf(buffer, UC_LIST_MAX_TEXT_LENGTH, "%d %s", index, get_test_text(list->progmem_font) + index % 8);
+	fit_text(buffer, list->x + 1, 1, list->progmem_font);
+}
+
+/*
+ * Draws a list and moves its selection, lists stay lower than 128 pixels
+ * too.
+ */
+void draw_list(void) {
+	uc_list list;
+	const uint8_t *font = random_font();
+	uint8_t x = random_text_x();
+	uint8_t width = random_size(x);
+	uint8_t height = random_below(80);
+	uint8_t y = random_coordinate_for(height);
+
+	uc_list_init_callback(&list, x, y, width, height, get_list_entry, &list, random_below(24), font);
+
+	for ( uint8_t step = 0; step < 4; step++ ) {
+		if ( random_below(2) ) uc_list_select(&list, random_below(32));
+		else uc_list_move(&list, (int16_t)random_below(9) - 4);
+	}
+}
+
+void draw_blit(void) {
+	uint8_t bitmap[3*24];
+	uint8_t mask[3*24];
+	uint8_t width = 1 + random_below(24);
+	uint8_t height = 1 + random_below(24);
+	uint8_t x = random_coordinate_for(width);
+	uint8_t y = random_coordinate_for(height);
+
+	for ( uint8_t i = 0; i < sizeof(bitmap); i++ ) {
+		bitmap[i] = random_next();
+		mask[i] = random_next();
+	}
+
+	LCD_API_BLIT(x, y, width, height, bitmap, random_below(2) ? mask : 0, 0);
+}
+
+void draw_save_restore_rect(void) {
+	uint8_t saved[4*32];
+	uint8_t width = 1 + random_below(32);
+	uint8_t height = 1 + random_below(24);
+	uint8_t x = random_coordinate_for(width);
+	uint8_t y = random_coordinate_for(height);
+
+	LCD_API_SAVE_RECT(x, y, width, height, saved);
+	draw_fill_rect();
+	LCD_API_RESTORE_RECT(x, y, width, height, saved);
+}
+
+void draw_sprites(void) {
+	int8_t ring = uc_sprites_add(test_sprite_ring, test_sprite_ring_mask, 12, 10);
+	int8_t block = uc_sprites_add(test_sprite_block, 0, 8, 8);
+
+	for ( uint8_t step = 0; step < 4; step++ ) {
+		uc_sprites_move(ring, random_coordinate_for(12), random_coordinate_for(10));
+		uc_sprites_move(block, random_coordinate_for(8), random_coordinate_for(8));
+
+		if ( random_below(4) ) uc_sprites_show(ring);
+		else uc_sprites_hide(ring);
+		if ( random_below(4) ) uc_sprites_show(block);
+		else uc_sprites_hide(block);
+
+		//Invalid handles are ignored
+		if ( !random_below(4) ) uc_sprites_move(random_below(2) ? -1 : UC_SPRITES_MAX, 0, 0);
+		if ( !random_below(4) ) uc_sprites_show(UC_SPRITES_MAX);
+
+		uc_sprites_update();
+	}
+
+	uc_sprites_init();
+}
+
+struct primitive_struct {
+	const char *name;
+	void (*draw)(void);
+};
+
+typedef struct primitive_struct primitive;
+
+const primitive primitives[] = {
+	{ "fill_rect", draw_fill_rect },
+	{ "invert_rect", draw_invert_rect },
+	{ "draw_rect", draw_rect },
+	{ "draw_line", draw_line },
+	{ "fill_rect_pattern", draw_fill_rect_pattern },
+	{ "fill_circle", draw_fill_circle },
+	{ "fill_circle_pattern", draw_fill_circle_pattern },
+	{ "fill_polygon", draw_fill_polygon },
+	{ "copy_rect", draw_copy_rect },
+	{ "scroll_rect", draw_scroll_rect },
+	{ "flood_fill", draw_flood_fill },
+	{ "images_draw", draw_image },
+	{ "images_draw_gray", draw_gray_image },
+	{ "fonts_draw_string", draw_string },
+	{ "fonts_draw_string_scaled", draw_string_scaled },
+	{ "fonts_draw_text", draw_text },
+	{ "text_layout", draw_text_layout },
+	{ "list", draw_list },
+	{ "lcd_blit", draw_blit },
+	{ "lcd_save_restore_rect", draw_save_restore_rect },
+	{ "sprites", draw_sprites }
+};
+
+#define PRIMITIVES_COUNT (sizeof(primitives) / sizeof(primitives[0]))
+
+/*
+ * Fills the buffer with a random background and picks a raster operation,
+ * a clip rectangle (in three of four cases) and a canvas as render target
+ * (in one of four cases).
+ */
+void prepare_case(uint32_t seed) {
+	random_state = seed;
+
+	LCD_API_SET_TARGET(0);
+	for ( uint16_t i = 0; i < 1024; i++ ) {
+		//Sparse background, so flood fills find regions
+		uc_lcd_buffer[i] = random_next() & random_next();
+	}
+
+	canvas_used = !random_below(4);
+	if ( canvas_used ) {
+		uc_lcd_canvas_init(&canvas, canvas_buffer, 1 + random_below(128), 1 + random_below(64));
+		for ( uint16_t i = 0; i < uc_lcd_canvas_get_size(canvas.width, canvas.height); i++ ) {
+			canvas_buffer[i] = random_next() & random_next();
+		}
+		LCD_API_SET_TARGET(&canvas);
+	}
+
+	if ( random_below(4) ) {
+		uint8_t x = random_coordinate();
+		uint8_t y = random_coordinate();
+		LCD_API_SET_CLIP(x, y, random_size(x), random_size(y));
+	} else {
+		LCD_API_RESET_CLIP();
+	}
+
+	LCD_API_SET_RASTER_OP(random_below(5));
+}
+
+/*
+ * Copies the canvas of a case onto the display, so it is compared too.
+ */
+void finish_case(void) {
+	LCD_API_RESET_CLIP();
+	if ( !canvas_used ) return;
+
+	LCD_API_SET_TARGET(0);
+	LCD_API_SET_RASTER_OP(LCD_RASTER_OP_COPY);
+	LCD_API_BLIT_CANVAS(0, 0, &canvas, 0);
+}
+
+double get_seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+ * Draws a primitive with random geometry until TIMING_SECONDS passed.
+ *
+ * returns: operations per second.
+ */
+double time_primitive(const primitive *p) {
+	uint32_t operations = 0;
+	double start;
+	double elapsed;
+
+	prepare_case(0x12345678);
+	LCD_API_SET_TARGET(0);
+	LCD_API_RESET_CLIP();
+	LCD_API_SET_RASTER_OP(LCD_RASTER_OP_COPY);
+
+	start = get_seconds();
+	do {
+		for ( uint8_t i = 0; i < 64; i++ ) p->draw();
+		operations += 64;
+		elapsed = get_seconds() - start;
+	} while ( elapsed < TIMING_SECONDS );
+
+	return operations / elapsed;
+}
+
+int main(int argc, char **argv) {
+	uint8_t writing;
+	FILE *file;
+	uint8_t expected[1024];
+	uint16_t failed_primitives = 0;
+
+	if ( argc != 3 || (strcmp(argv[1], "-w") && strcmp(argv[1], "-c")) ) {
+		fprintf(stderr, "usage: %s -w|-c FILE\n", argv[0]);
+		return 2;
+	}
+
+	writing = argv[1][1] == 'w';
+	file = fopen(argv[2], writing ? "wb" : "rb");
+	if ( !file ) {
+		perror(argv[2]);
+		return 2;
+	}
+
+	uc_lcd_init();
+	uc_sprites_init();
+	build_fonts();
+
+	printf("%s paths, %d cases per primitive\n\n", PATH_NAME, CASES_PER_PRIMITIVE);
+	printf("%-26s %-12s %-10s %12s\n", "primitive", "buffers", "checksum", "ops/s");
+
+	for ( uint8_t p = 0; p < PRIMITIVES_COUNT; p++ ) {
+		uint16_t differing = 0;
+		uint16_t checksum = 0;
+
+		for ( uint16_t c = 0; c < CASES_PER_PRIMITIVE; c++ ) {
+			prepare_case(0x9E3779B9u * (p * CASES_PER_PRIMITIVE + c + 1));
+			primitives[p].draw();
+			finish_case();
+
+			checksum = ((checksum << 1) | (checksum >> 15)) ^ LCD_API_GET_BUFFER_CHECKSUM();
+
+			if ( writing ) {
+				fwrite(uc_lcd_buffer, 1, 1024, file);
+				continue;
+			}
+
+			if ( fread(expected, 1, 1024, file) != 1024 ) {
+				fprintf(stderr, "%s: reference file is too short\n", argv[2]);
+				return 1;
+			}
+
+			if ( memcmp(expected, uc_lcd_buffer, 1024) ) {
+				uint16_t i = 0;
+				while ( expected[i] == uc_lcd_buffer[i] ) i++;
+
+				if ( differing < MAX_REPORTED_CASES ) {
+					fprintf(stderr, "%s case %d: byte %d (page %d, column %d) is %02x, reference %02x\n",
+							primitives[p].name, c, i, (i % 512) / 64, (i / 512) * 64 + i % 64,
+							uc_lcd_buffer[i], expected[i]);
+				}
+				differing++;
+			}
+		}
+
+		//The checksum of all cases follows the buffers of a primitive
+		uint8_t checksum_bytes[2] = { checksum & 0xFF, checksum >> 8 };
+		uint8_t checksum_differs = 0;
+
+		if ( writing ) {
+			fwrite(checksum_bytes, 1, 2, file);
+		} else {
+			uint8_t expected_checksum[2];
+			if ( fread(expected_checksum, 1, 2, file) != 2 ) {
+				fprintf(stderr, "%s: reference file is too short\n", argv[2]);
+				return 1;
+			}
+			checksum_differs = memcmp(expected_checksum, checksum_bytes, 2) != 0;
+		}
+
+		if ( differing || checksum_differs ) failed_primitives++;
+
+		char result[16];
+		if ( writing ) {
+			snprintf(result, sizeof(result), "written");
+		} else if ( differing ) {
+			snprintf(result, sizeof(result), "%d differ", differing);
+		} else if ( checksum_differs ) {
+			snprintf(result, sizeof(result), "checksum");
+		} else {
+			snprintf(result, sizeof(result), "equal");
+		}
+
+		printf("%-26s %-12s %04x       %12.0f\n",
+			   primitives[p].name, result, checksum, time_primitive(&primitives[p]));
+	}
+
+	if ( !writing && fgetc(file) != EOF ) {
+		fprintf(stderr, "%s: reference file is too long\n", argv[2]);
+		failed_primitives++;
+	}
+
+	fclose(file);
+	return failed_primitives ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * LCD setup of the host runner: buffered mode, the data and control
+ * "registers" are plain variables.
+ */
+
+#ifndef UC_HOST_LCD_CONFIG_H_
+#define UC_HOST_LCD_CONFIG_H_
+
+#include <stdint.h>
+
+volatile uint8_t host_ddr_data;
+volatile uint8_t host_port_data;
+volatile uint8_t host_ddr_control;
+volatile uint8_t host_port_control;
+
+#define LCD_MODE_BUFFERED
+
+#define LCD_DATA_MODE_PARALLEL
+#define LCD_DMP_CONTROL_TOGETHER
+#define LCD_DMP_DDR_DATA			host_ddr_data
+#define LCD_DMP_PORT_DATA			host_port_data
+#define LCD_DMP_DDR_CONTROL			host_ddr_control
+#define LCD_DMP_PORT_CONTROL		host_port_control
+#define LCD_DMP_PIN_CSEL1			0
+#define LCD_DMP_PIN_CSEL2			1
+#define LCD_DMP_PIN_COMMAND_DATA	2
+#define LCD_DMP_PIN_ENABLE			3
+
+#endif
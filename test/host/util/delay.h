@@ -0,0 +1,11 @@
+/*
+ * Host stand-in for avr-libc's <util/delay.h>: there is no LCD to wait for.
+ */
+
+#ifndef UC_HOST_UTIL_DELAY_H_
+#define UC_HOST_UTIL_DELAY_H_
+
+#define _delay_us(us)	do { } while ( 0 )
+#define _delay_ms(ms)	do { } while ( 0 )
+
+#endif